@@ -0,0 +1,589 @@
+/*
+ * ASYNC IO - Implementation
+ *
+ * io_uring is driven through the raw syscalls (no liburing): the SQ/CQ
+ * rings and the SQE array are mmapped from the ring fd. The kernel
+ * consumes SQEs synchronously in io_uring_enter() (no SQPOLL), so this
+ * thread is the only writer of sq_tail and cq_head; the indices shared
+ * with the kernel are read with acquire and published with release.
+ *
+ * Capacity: prepared + inflight never exceeds ASYNC_IO_QUEUE_DEPTH, the
+ * SQ size. The CQ is twice as large, so completions cannot overflow.
+ */
+
+#define _GNU_SOURCE  /* syscall() */
+
+#include "async_io.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// ============================================
+// IO_URING BACKEND
+// ============================================
+
+static int uring_setup(unsigned entries, struct io_uring_params *params) {
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static int uring_register(int fd, unsigned opcode, const void *arg, unsigned count) {
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, count);
+}
+
+static void uring_unmap(AsyncIoUring *ring) {
+    if (ring->sqes != NULL) {
+        munmap(ring->sqes, ring->sqes_size);
+    }
+    if (ring->cq_map != NULL && ring->cq_map != ring->sq_map) {
+        munmap(ring->cq_map, ring->cq_map_size);
+    }
+    if (ring->sq_map != NULL) {
+        munmap(ring->sq_map, ring->sq_map_size);
+    }
+    close(ring->fd);
+}
+
+static void *map_ring(int fd, size_t size, off_t offset) {
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    return (map == MAP_FAILED) ? NULL : map;
+}
+
+static bool uring_init(AsyncIo *io) {
+    AsyncIoUring *ring = &io->uring;
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    memset(ring, 0, sizeof(*ring));
+
+    ring->fd = uring_setup(ASYNC_IO_QUEUE_DEPTH, &params);
+    if (ring->fd < 0) {
+        return false;  // ENOSYS, EPERM (seccomp / sysctl), ...
+    }
+    // IORING_OP_READ/WRITE arrived with the same kernel (5.6) as this flag
+    if (!(params.features & IORING_FEAT_RW_CUR_POS) || params.sq_entries < ASYNC_IO_QUEUE_DEPTH) {
+        close(ring->fd);
+        return false;
+    }
+
+    ring->sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cq_map_size > ring->sq_map_size) {
+            ring->sq_map_size = ring->cq_map_size;
+        }
+        ring->cq_map_size = ring->sq_map_size;
+    }
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    ring->sq_map = map_ring(ring->fd, ring->sq_map_size, IORING_OFF_SQ_RING);
+    if (ring->sq_map != NULL && (params.features & IORING_FEAT_SINGLE_MMAP)) {
+        ring->cq_map = ring->sq_map;
+    } else if (ring->sq_map != NULL) {
+        ring->cq_map = map_ring(ring->fd, ring->cq_map_size, IORING_OFF_CQ_RING);
+    }
+    ring->sqes = map_ring(ring->fd, ring->sqes_size, IORING_OFF_SQES);
+    if (ring->sq_map == NULL || ring->cq_map == NULL || ring->sqes == NULL) {
+        uring_unmap(ring);
+        return false;
+    }
+
+    uint8_t *sq = ring->sq_map;
+    uint8_t *cq = ring->cq_map;
+    ring->sq_head = (unsigned *)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned *)(sq + params.sq_off.tail);
+    ring->sq_array = (unsigned *)(sq + params.sq_off.array);
+    ring->sq_mask = *(unsigned *)(sq + params.sq_off.ring_mask);
+    ring->cq_head = (unsigned *)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+    ring->cq_mask = *(unsigned *)(cq + params.cq_off.ring_mask);
+    ring->cqes = cq + params.cq_off.cqes;
+    ring->local_tail = *ring->sq_tail;
+
+    // Fixed buffers: pages pinned once instead of per request. Locked
+    // memory is limited (RLIMIT_MEMLOCK); without it plain opcodes work.
+    struct iovec iov[ASYNC_IO_POOL_BUFFERS];
+    for (size_t i = 0; i < ASYNC_IO_POOL_BUFFERS; i++) {
+        iov[i].iov_base = io->buffers[i];
+        iov[i].iov_len = ASYNC_IO_BUFFER_SIZE;
+    }
+    ring->buffers_registered =
+        (uring_register(ring->fd, IORING_REGISTER_BUFFERS, iov, ASYNC_IO_POOL_BUFFERS) == 0);
+    return true;
+}
+
+/* Pool buffer holding [buf, buf + len), or -1 */
+static int pool_index(const AsyncIo *io, const void *buf, size_t len) {
+    const uint8_t *p = buf;
+    const uint8_t *base = &io->buffers[0][0];
+    if (p < base || p >= base + sizeof(io->buffers)) {
+        return -1;
+    }
+    size_t index = (size_t)(p - base) / ASYNC_IO_BUFFER_SIZE;
+    size_t start = (size_t)(p - io->buffers[index]);
+    return (start + len <= ASYNC_IO_BUFFER_SIZE) ? (int)index : -1;
+}
+
+static void uring_prep(AsyncIo *io, const AsyncIoRequest *request) {
+    AsyncIoUring *ring = &io->uring;
+    unsigned index = ring->local_tail & ring->sq_mask;
+    struct io_uring_sqe *sqe = &((struct io_uring_sqe *)ring->sqes)[index];
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->fd = request->fd;
+    sqe->user_data = request->user_data;
+    if (request->op == ASYNC_IO_OP_FSYNC) {
+        sqe->opcode = IORING_OP_FSYNC;
+    } else {
+        bool write = (request->op == ASYNC_IO_OP_WRITE);
+        int fixed = ring->buffers_registered ? pool_index(io, request->buf, request->len) : -1;
+        if (fixed >= 0) {
+            sqe->opcode = write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+            sqe->buf_index = (uint16_t)fixed;
+        } else {
+            sqe->opcode = write ? IORING_OP_WRITE : IORING_OP_READ;
+        }
+        sqe->addr = (uint64_t)(uintptr_t)request->buf;
+        sqe->len = request->len;
+        sqe->off = request->offset;
+    }
+
+    ring->sq_array[index] = index;
+    ring->local_tail++;
+}
+
+static int uring_submit(AsyncIo *io) {
+    AsyncIoUring *ring = &io->uring;
+    __atomic_store_n(ring->sq_tail, ring->local_tail, __ATOMIC_RELEASE);
+
+    int submitted;
+    // Rule 2: Bounded retries on signals
+    for (int attempt = 0; attempt < 8; attempt++) {
+        submitted = uring_enter(ring->fd, (unsigned)io->prepared, 0, 0);
+        if (submitted >= 0 || errno != EINTR) {
+            break;
+        }
+    }
+    if (submitted < 0) {
+        return -errno;
+    }
+    // Entries the kernel did not take stay in the SQ for the next call
+    return submitted;
+}
+
+/* Completions already posted; no syscall */
+static size_t uring_collect(AsyncIo *io, AsyncIoCompletion *out, size_t max) {
+    AsyncIoUring *ring = &io->uring;
+    unsigned head = *ring->cq_head;
+    unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+    const struct io_uring_cqe *cqes = ring->cqes;
+
+    size_t n = 0;
+    while (head != tail && n < max) {
+        const struct io_uring_cqe *cqe = &cqes[head & ring->cq_mask];
+        out[n].user_data = cqe->user_data;
+        out[n].result = cqe->res;
+        n++;
+        head++;
+    }
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    return n;
+}
+
+static size_t uring_reap(AsyncIo *io, AsyncIoCompletion *out, size_t max, size_t min_wait) {
+    size_t n = uring_collect(io, out, max);
+    // Rule 2: Each wait posts at least one completion (or is a signal)
+    for (size_t attempt = 0; n < min_wait && attempt < 2 * ASYNC_IO_QUEUE_DEPTH; attempt++) {
+        int rc = uring_enter(io->uring.fd, 0, (unsigned)(min_wait - n),
+                             IORING_ENTER_GETEVENTS);
+        if (rc < 0 && errno != EINTR) {
+            break;
+        }
+        n += uring_collect(io, out + n, max - n);
+    }
+    return n;
+}
+
+// ============================================
+// THREAD POOL BACKEND
+// ============================================
+
+static int32_t run_request(const AsyncIoRequest *request) {
+    ssize_t rc;
+    // Rule 2: Bounded retries on signals
+    for (int attempt = 0; attempt < 8; attempt++) {
+        switch (request->op) {
+        case ASYNC_IO_OP_READ:
+            rc = pread(request->fd, request->buf, request->len, (off_t)request->offset);
+            break;
+        case ASYNC_IO_OP_WRITE:
+            rc = pwrite(request->fd, request->buf, request->len, (off_t)request->offset);
+            break;
+        default:
+            rc = fsync(request->fd);
+            break;
+        }
+        if (rc >= 0) {
+            return (int32_t)rc;
+        }
+        if (errno != EINTR) {
+            break;
+        }
+    }
+    return -errno;  // Same convention as io_uring's cqe->res
+}
+
+static void *worker_main(void *arg) {
+    AsyncIoPool *pool = arg;
+
+    pthread_mutex_lock(&pool->lock);
+    // Task loop: runs until async_io_destroy() sets stop
+    for (;;) {
+        while (pool->queue_count == 0 && !pool->stop) {
+            pthread_cond_wait(&pool->work, &pool->lock);
+        }
+        if (pool->queue_count == 0) {
+            break;
+        }
+        AsyncIoRequest request = pool->queue[pool->queue_head];
+        pool->queue_head = (pool->queue_head + 1) % ASYNC_IO_QUEUE_DEPTH;
+        pool->queue_count--;
+        pthread_mutex_unlock(&pool->lock);
+
+        int32_t result = run_request(&request);
+
+        pthread_mutex_lock(&pool->lock);
+        size_t slot = (pool->completion_head + pool->completion_count) % ASYNC_IO_QUEUE_DEPTH;
+        pool->completions[slot].user_data = request.user_data;
+        pool->completions[slot].result = result;
+        pool->completion_count++;
+        pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+static void pool_stop(AsyncIoPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->work);
+    pthread_mutex_unlock(&pool->lock);
+    for (size_t i = 0; i < pool->thread_count; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->work);
+    pthread_mutex_destroy(&pool->lock);
+}
+
+static bool pool_init(AsyncIoPool *pool) {
+    pool->queue_head = 0;
+    pool->queue_count = 0;
+    pool->completion_head = 0;
+    pool->completion_count = 0;
+    pool->stop = false;
+    pool->thread_count = 0;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    for (size_t i = 0; i < ASYNC_IO_WORKERS; i++) {
+        if (pthread_create(&pool->threads[i], NULL, worker_main, pool) != 0) {
+            break;
+        }
+        pool->thread_count++;
+    }
+    if (pool->thread_count == 0) {
+        pool_stop(pool);
+        return false;
+    }
+    return true;
+}
+
+static int pool_submit(AsyncIo *io) {
+    AsyncIoPool *pool = &io->pool;
+
+    pthread_mutex_lock(&pool->lock);
+    for (size_t i = 0; i < io->prepared; i++) {
+        size_t slot = (pool->queue_head + pool->queue_count) % ASYNC_IO_QUEUE_DEPTH;
+        pool->queue[slot] = io->staged[i];
+        pool->queue_count++;
+    }
+    pthread_cond_broadcast(&pool->work);
+    pthread_mutex_unlock(&pool->lock);
+    return (int)io->prepared;
+}
+
+static size_t pool_reap(AsyncIo *io, AsyncIoCompletion *out, size_t max, size_t min_wait) {
+    AsyncIoPool *pool = &io->pool;
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->completion_count < min_wait) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    size_t n = 0;
+    while (pool->completion_count > 0 && n < max) {
+        out[n++] = pool->completions[pool->completion_head];
+        pool->completion_head = (pool->completion_head + 1) % ASYNC_IO_QUEUE_DEPTH;
+        pool->completion_count--;
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return n;
+}
+
+// ============================================
+// PUBLIC API
+// ============================================
+
+bool async_io_init(AsyncIo *io, AsyncIoBackend preferred) {
+    assert(io != NULL);
+
+    io->prepared = 0;
+    io->inflight = 0;
+    if (preferred == ASYNC_IO_BACKEND_URING && uring_init(io)) {
+        io->backend = ASYNC_IO_BACKEND_URING;
+        return true;
+    }
+    io->backend = ASYNC_IO_BACKEND_THREADS;
+    return pool_init(&io->pool);
+}
+
+void async_io_destroy(AsyncIo *io) {
+    assert(io != NULL);
+
+    if (io->prepared > 0) {
+        (void)async_io_submit(io);
+    }
+    AsyncIoCompletion discard[ASYNC_IO_QUEUE_DEPTH];
+    // Rule 2: Buffers must outlive the requests; each pass retires >= 1
+    for (size_t pass = 0; io->inflight > 0 && pass < ASYNC_IO_QUEUE_DEPTH; pass++) {
+        (void)async_io_reap(io, discard, ASYNC_IO_QUEUE_DEPTH, io->inflight);
+    }
+
+    if (io->backend == ASYNC_IO_BACKEND_URING) {
+        uring_unmap(&io->uring);
+    } else {
+        pool_stop(&io->pool);
+    }
+}
+
+AsyncIoBackend async_io_backend(const AsyncIo *io) {
+    assert(io != NULL);
+    return io->backend;
+}
+
+uint8_t *async_io_buffer(AsyncIo *io, size_t index) {
+    assert(io != NULL && index < ASYNC_IO_POOL_BUFFERS);
+    return io->buffers[index];
+}
+
+static bool prep(AsyncIo *io, const AsyncIoRequest *request) {
+    if (io->prepared + io->inflight >= ASYNC_IO_QUEUE_DEPTH) {
+        return false;  // Rule 5: Caller reaps first
+    }
+    if (io->backend == ASYNC_IO_BACKEND_URING) {
+        uring_prep(io, request);
+    } else {
+        io->staged[io->prepared] = *request;
+    }
+    io->prepared++;
+    return true;
+}
+
+bool async_io_prep_read(AsyncIo *io, int fd, void *buf, size_t len, uint64_t offset,
+                        uint64_t user_data) {
+    assert(io != NULL && buf != NULL && len <= UINT32_MAX);
+
+    AsyncIoRequest request = {ASYNC_IO_OP_READ, fd, buf, (uint32_t)len, offset, user_data};
+    return prep(io, &request);
+}
+
+bool async_io_prep_write(AsyncIo *io, int fd, const void *buf, size_t len, uint64_t offset,
+                         uint64_t user_data) {
+    assert(io != NULL && buf != NULL && len <= UINT32_MAX);
+
+    // The request never writes through buf; the cast only shares the struct
+    AsyncIoRequest request = {ASYNC_IO_OP_WRITE, fd, (void *)(uintptr_t)buf, (uint32_t)len,
+                              offset, user_data};
+    return prep(io, &request);
+}
+
+bool async_io_prep_fsync(AsyncIo *io, int fd, uint64_t user_data) {
+    assert(io != NULL);
+
+    AsyncIoRequest request = {ASYNC_IO_OP_FSYNC, fd, NULL, 0, 0, user_data};
+    return prep(io, &request);
+}
+
+int async_io_submit(AsyncIo *io) {
+    assert(io != NULL);
+
+    if (io->prepared == 0) {
+        return 0;
+    }
+    int submitted = (io->backend == ASYNC_IO_BACKEND_URING) ? uring_submit(io) : pool_submit(io);
+    if (submitted > 0) {
+        io->prepared -= (size_t)submitted;
+        io->inflight += (size_t)submitted;
+    }
+    return submitted;
+}
+
+size_t async_io_reap(AsyncIo *io, AsyncIoCompletion *out, size_t max, size_t min_wait) {
+    assert(io != NULL && out != NULL);
+
+    if (min_wait > io->inflight) {
+        min_wait = io->inflight;
+    }
+    if (min_wait > max) {
+        min_wait = max;
+    }
+    size_t n = (io->backend == ASYNC_IO_BACKEND_URING) ? uring_reap(io, out, max, min_wait)
+                                                       : pool_reap(io, out, max, min_wait);
+    assert(n <= io->inflight);  // Rule 7
+    io->inflight -= n;
+    return n;
+}
+
+size_t async_io_inflight(const AsyncIo *io) {
+    assert(io != NULL);
+    return io->inflight;
+}
+
+// ============================================
+// SEQUENTIAL STREAM WRITER
+// ============================================
+
+/* Queue the unwritten part of slot index */
+static bool stream_queue(AsyncIoStream *stream, size_t index) {
+    AsyncIoStreamSlot *slot = &stream->slots[index];
+    const uint8_t *data = async_io_buffer(stream->io, index) + slot->written;
+
+    if (!async_io_prep_write(stream->io, stream->fd, data, slot->length - slot->written,
+                             slot->offset + slot->written, index)) {
+        return false;
+    }
+    return async_io_submit(stream->io) > 0;
+}
+
+static void stream_complete(AsyncIoStream *stream, const AsyncIoCompletion *completion) {
+    assert(completion->user_data < ASYNC_IO_POOL_BUFFERS);  // Rule 7
+    AsyncIoStreamSlot *slot = &stream->slots[completion->user_data];
+
+    if (completion->result <= 0) {
+        stream->failed = true;  // -errno, or no progress (disk full)
+        slot->busy = false;
+        return;
+    }
+    slot->written += (uint32_t)completion->result;
+    if (slot->written < slot->length && !stream->failed) {
+        // Short write: the rest of this buffer goes out again
+        if (stream_queue(stream, (size_t)completion->user_data)) {
+            return;
+        }
+        stream->failed = true;
+    }
+    slot->busy = false;
+}
+
+/* Retire completions, blocking for at least one */
+static void stream_reap(AsyncIoStream *stream) {
+    AsyncIoCompletion completions[ASYNC_IO_POOL_BUFFERS];
+    size_t n = async_io_reap(stream->io, completions, ASYNC_IO_POOL_BUFFERS, 1);
+    for (size_t i = 0; i < n; i++) {
+        stream_complete(stream, &completions[i]);
+    }
+}
+
+/* Wait until slot index may be refilled */
+static void stream_wait(AsyncIoStream *stream, size_t index) {
+    // Rule 2: Only this slot's writes remain, each reap retires one
+    while (stream->slots[index].busy && async_io_inflight(stream->io) > 0) {
+        stream_reap(stream);
+    }
+    stream->slots[index].busy = false;
+}
+
+/* Hand the current buffer to the kernel and move to the next one */
+static void stream_submit_current(AsyncIoStream *stream) {
+    size_t index = stream->current;
+    AsyncIoStreamSlot *slot = &stream->slots[index];
+
+    slot->offset = stream->offset;
+    slot->length = (uint32_t)stream->used;
+    slot->written = 0;
+    slot->busy = true;
+    if (!stream_queue(stream, index)) {
+        stream->failed = true;
+        slot->busy = false;
+    }
+
+    stream->offset += stream->used;
+    stream->used = 0;
+    stream->current = (index + 1) % ASYNC_IO_POOL_BUFFERS;
+    stream_wait(stream, stream->current);
+}
+
+bool async_io_stream_open(AsyncIoStream *stream, AsyncIo *io, const char *filename) {
+    assert(stream != NULL && io != NULL && filename != NULL);
+    assert(async_io_inflight(io) == 0);  // Rule 7: the stream owns io
+
+    stream->fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (stream->fd < 0) {
+        return false;
+    }
+    stream->io = io;
+    stream->offset = 0;
+    stream->current = 0;
+    stream->used = 0;
+    stream->failed = false;
+    memset(stream->slots, 0, sizeof(stream->slots));
+    return true;
+}
+
+bool async_io_stream_write(AsyncIoStream *stream, const void *data, size_t len) {
+    assert(stream != NULL && (data != NULL || len == 0));
+
+    const uint8_t *src = data;
+    // Rule 2: Each pass consumes at least one byte
+    while (len > 0 && !stream->failed) {
+        size_t space = ASYNC_IO_BUFFER_SIZE - stream->used;
+        size_t chunk = (len < space) ? len : space;
+        memcpy(async_io_buffer(stream->io, stream->current) + stream->used, src, chunk);
+        stream->used += chunk;
+        src += chunk;
+        len -= chunk;
+
+        if (stream->used == ASYNC_IO_BUFFER_SIZE) {
+            stream_submit_current(stream);
+        }
+    }
+    return !stream->failed;
+}
+
+bool async_io_stream_close(AsyncIoStream *stream) {
+    assert(stream != NULL);
+
+    if (stream->used > 0 && !stream->failed) {
+        stream_submit_current(stream);
+    }
+    // Rule 2: Bounded by ASYNC_IO_POOL_BUFFERS slots
+    for (size_t i = 0; i < ASYNC_IO_POOL_BUFFERS; i++) {
+        stream_wait(stream, i);
+    }
+
+    if (close(stream->fd) != 0) {  // Rule 5: Check return
+        stream->failed = true;
+    }
+    stream->fd = -1;
+    return !stream->failed;
+}
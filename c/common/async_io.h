@@ -0,0 +1,164 @@
+/*
+ * ASYNC IO - Batched file reads/writes on io_uring, thread-pool fallback
+ *
+ * Requests are prepared locally, handed to the kernel in one batch by
+ * async_io_submit(), and completions are reaped from the shared
+ * completion ring without a syscall (one io_uring_enter only when the
+ * caller asks to wait). A fixed pool of ASYNC_IO_POOL_BUFFERS buffers
+ * lives inside AsyncIo and is registered with the ring; reads and
+ * writes whose memory lies in the pool use the *_FIXED opcodes, so the
+ * kernel does not pin pages per request.
+ *
+ * When io_uring is unavailable (old kernel, seccomp, disabled by
+ * sysctl) the same API is served by ASYNC_IO_WORKERS threads doing
+ * pread/pwrite/fsync.
+ *
+ * AsyncIoStream builds a sequential writer on top: it fills one pool
+ * buffer while the kernel writes the others, so a single thread keeps
+ * formatting while earlier data is written.
+ *
+ * Not thread-safe: one thread owns an AsyncIo. Linux only.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c async_io.c
+ */
+
+#ifndef ASYNC_IO_H
+#define ASYNC_IO_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define ASYNC_IO_QUEUE_DEPTH 32            /* Prepared + in flight (Rule 3) */
+#define ASYNC_IO_POOL_BUFFERS 4
+#define ASYNC_IO_BUFFER_SIZE (64 * 1024)
+#define ASYNC_IO_WORKERS 2                 /* Fallback threads */
+
+typedef enum {
+    ASYNC_IO_BACKEND_URING = 0,
+    ASYNC_IO_BACKEND_THREADS
+} AsyncIoBackend;
+
+typedef enum {
+    ASYNC_IO_OP_READ = 0,
+    ASYNC_IO_OP_WRITE,
+    ASYNC_IO_OP_FSYNC
+} AsyncIoOp;
+
+typedef struct {
+    uint64_t user_data;
+    int32_t result;  /* Bytes transferred, 0 for fsync, or -errno */
+} AsyncIoCompletion;
+
+typedef struct {
+    AsyncIoOp op;
+    int fd;
+    void *buf;
+    uint32_t len;
+    uint64_t offset;
+    uint64_t user_data;
+} AsyncIoRequest;
+
+/* Kernel rings, mapped from the io_uring fd (not malloc) */
+typedef struct {
+    int fd;
+    void *sq_map;
+    size_t sq_map_size;
+    void *cq_map;           /* == sq_map with IORING_FEAT_SINGLE_MMAP */
+    size_t cq_map_size;
+    void *sqes;             /* struct io_uring_sqe[sq_entries] */
+    size_t sqes_size;
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_array;
+    unsigned sq_mask;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned cq_mask;
+    void *cqes;             /* struct io_uring_cqe[cq_entries] */
+    unsigned local_tail;    /* Prepared entries not yet published */
+    bool buffers_registered;
+} AsyncIoUring;
+
+typedef struct {
+    pthread_t threads[ASYNC_IO_WORKERS];
+    size_t thread_count;
+    pthread_mutex_t lock;
+    pthread_cond_t work;
+    pthread_cond_t done;
+    AsyncIoRequest queue[ASYNC_IO_QUEUE_DEPTH];
+    size_t queue_head;
+    size_t queue_count;
+    AsyncIoCompletion completions[ASYNC_IO_QUEUE_DEPTH];
+    size_t completion_head;
+    size_t completion_count;
+    bool stop;
+} AsyncIoPool;
+
+typedef struct {
+    _Alignas(4096) uint8_t buffers[ASYNC_IO_POOL_BUFFERS][ASYNC_IO_BUFFER_SIZE];
+    AsyncIoBackend backend;
+    size_t prepared;  /* Not yet submitted */
+    size_t inflight;  /* Submitted, not yet reaped */
+    AsyncIoUring uring;
+    AsyncIoPool pool;
+    AsyncIoRequest staged[ASYNC_IO_QUEUE_DEPTH];  /* Thread backend */
+} AsyncIo;
+
+typedef struct {
+    uint64_t offset;   /* File offset of the buffer's first byte */
+    uint32_t length;   /* Bytes submitted */
+    uint32_t written;  /* Bytes completed so far */
+    bool busy;
+} AsyncIoStreamSlot;
+
+typedef struct {
+    AsyncIo *io;
+    int fd;
+    uint64_t offset;   /* File offset of the buffer being filled */
+    size_t current;    /* Pool buffer being filled */
+    size_t used;
+    AsyncIoStreamSlot slots[ASYNC_IO_POOL_BUFFERS];
+    bool failed;
+} AsyncIoStream;
+
+/* Start on io_uring (or directly on threads); false if neither works */
+bool async_io_init(AsyncIo *io, AsyncIoBackend preferred);
+
+/* Stop the workers / unmap the rings. Waits for requests in flight. */
+void async_io_destroy(AsyncIo *io);
+
+AsyncIoBackend async_io_backend(const AsyncIo *io);
+
+/* Pool buffer index (ASYNC_IO_BUFFER_SIZE bytes); I/O on it is "fixed" */
+uint8_t *async_io_buffer(AsyncIo *io, size_t index);
+
+/* Queue a request; false if ASYNC_IO_QUEUE_DEPTH are prepared or in flight */
+bool async_io_prep_read(AsyncIo *io, int fd, void *buf, size_t len, uint64_t offset,
+                        uint64_t user_data);
+bool async_io_prep_write(AsyncIo *io, int fd, const void *buf, size_t len, uint64_t offset,
+                         uint64_t user_data);
+bool async_io_prep_fsync(AsyncIo *io, int fd, uint64_t user_data);
+
+/* Hand every prepared request over in one batch; -errno on failure */
+int async_io_submit(AsyncIo *io);
+
+/* Copy up to max completions, blocking until at least min_wait arrived
+ * (capped at the number in flight). Returns how many were copied. */
+size_t async_io_reap(AsyncIo *io, AsyncIoCompletion *out, size_t max, size_t min_wait);
+
+size_t async_io_inflight(const AsyncIo *io);
+
+/* Truncate/create filename (like fopen "w") and write it sequentially;
+ * the stream owns io until closed */
+bool async_io_stream_open(AsyncIoStream *stream, AsyncIo *io, const char *filename);
+
+/* Append len bytes; false once any write failed */
+bool async_io_stream_write(AsyncIoStream *stream, const void *data, size_t len);
+
+/* Write the tail, wait for every write and close the file; false if
+ * any write or the close failed */
+bool async_io_stream_close(AsyncIoStream *stream);
+
+#endif /* ASYNC_IO_H */
@@ -0,0 +1,22 @@
+/*
+ * BOUNDED STRING - Implementation
+ */
+
+#define _POSIX_C_SOURCE 200809L  // strnlen
+
+#include "bounded_string.h"
+
+#include <assert.h>
+#include <string.h>
+
+size_t bstr_copy(char *dest, size_t dest_size, const char *src) {
+    assert(dest != NULL);
+    assert(src != NULL);
+    assert(dest_size > 0);
+
+    size_t len = strnlen(src, dest_size);
+    size_t n = (len < dest_size) ? len : dest_size - 1;
+    memcpy(dest, src, n);
+    dest[n] = '\0';
+    return len;
+}
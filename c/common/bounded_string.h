@@ -0,0 +1,22 @@
+/*
+ * BOUNDED STRING - Truncating copy into a fixed-size field
+ *
+ * bstr_copy() is strnlen + memcpy: the source is read up to its
+ * terminator or dest_size bytes, whichever comes first, and nothing is
+ * written past the terminator. strncpy zero-fills the rest of dest,
+ * which costs more than the copy itself for short strings in 64-128 byte
+ * fields (the message queue and hash table records of memory-safety).
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c bounded_string.c
+ */
+
+#ifndef BOUNDED_STRING_H
+#define BOUNDED_STRING_H
+
+#include <stddef.h>
+
+/* Copy src into dest[dest_size] (dest_size > 0), always terminated.
+ * Returns strlen(src) if it fit, dest_size if src was truncated. */
+size_t bstr_copy(char *dest, size_t dest_size, const char *src);
+
+#endif /* BOUNDED_STRING_H */
@@ -0,0 +1,307 @@
+/*
+ * CHECKSUM - Implementation
+ *
+ * Slicing-by-8: table k maps a byte to its CRC contribution k bytes
+ * further down the stream, so 8 bytes cost 8 independent lookups instead
+ * of 8 dependent shift-and-lookup steps.
+ *
+ * Three-stream hardware CRC: the CRC register is linear, so
+ * crc(A || B) = shift(crc(A), |B|) ^ crc(B) where crc(B) starts from 0
+ * and shift() feeds |B| zero bytes. A block of three lanes is computed as
+ * three independent instruction chains and merged with two shifts by one
+ * lane, each four lookups in a table built from the 32 single-bit shifts.
+ */
+
+#define _POSIX_C_SOURCE 200809L  /* pthread_once */
+
+#include "checksum.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <string.h>
+
+#include "cpu_features.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CHECKSUM_HAVE_SIMD_PATH 1
+#include <immintrin.h>
+#else
+#define CHECKSUM_HAVE_SIMD_PATH 0
+#endif
+
+#define CRC32C_POLY 0x82F63B78u   // Reflected Castagnoli polynomial
+#define CRC32C_LANE_BYTES 512u    // One stream of a three-stream block
+#define SUM_FLUSH_WORDS 128u      // 16-bit SWAR lanes hold 128 * 510
+
+// ============================================
+// TABLES
+// ============================================
+
+static uint32_t slice_table[8][256];
+static uint32_t lane_shift_table[4][256];  // Byte k of the register, one lane later
+static pthread_once_t tables_once = PTHREAD_ONCE_INIT;
+
+/* The register after `bytes` zero bytes */
+static uint32_t shift_zeros(uint32_t crc, size_t bytes) {
+    for (size_t i = 0; i < bytes; i++) {
+        crc = (crc >> 8) ^ slice_table[0][crc & 0xFFu];
+    }
+    return crc;
+}
+
+static void build_tables(void) {
+    for (uint32_t byte = 0; byte < 256; byte++) {
+        uint32_t crc = byte;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ ((crc & 1u) ? CRC32C_POLY : 0u);
+        }
+        slice_table[0][byte] = crc;
+    }
+    for (int k = 1; k < 8; k++) {
+        for (uint32_t byte = 0; byte < 256; byte++) {
+            uint32_t prev = slice_table[k - 1][byte];
+            slice_table[k][byte] = (prev >> 8) ^ slice_table[0][prev & 0xFFu];
+        }
+    }
+
+    uint32_t bit_shift[32];
+    for (int bit = 0; bit < 32; bit++) {
+        bit_shift[bit] = shift_zeros(1u << bit, CRC32C_LANE_BYTES);
+    }
+    for (int k = 0; k < 4; k++) {
+        for (uint32_t byte = 0; byte < 256; byte++) {
+            uint32_t shifted = 0;
+            for (int bit = 0; bit < 8; bit++) {
+                shifted ^= (byte & (1u << bit)) ? bit_shift[8 * k + bit] : 0u;
+            }
+            lane_shift_table[k][byte] = shifted;
+        }
+    }
+}
+
+/* Built exactly once; concurrent first callers wait for the builder */
+static inline void ensure_tables(void) {
+    int rc = pthread_once(&tables_once, build_tables);
+    assert(rc == 0);  // Rule 5: Check return
+    (void)rc;
+}
+
+// ============================================
+// SCALAR KERNELS
+// ============================================
+
+static inline uint32_t load_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+static inline uint64_t load_word(const uint8_t *p) {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+/* Raw register update (no pre/post inversion) */
+static uint32_t crc32c_slicing(uint32_t crc, const uint8_t *p, size_t size) {
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint32_t lo = load_le32(p + i) ^ crc;
+        uint32_t hi = load_le32(p + i + 4);
+        crc = slice_table[7][lo & 0xFFu] ^ slice_table[6][(lo >> 8) & 0xFFu] ^
+              slice_table[5][(lo >> 16) & 0xFFu] ^ slice_table[4][lo >> 24] ^
+              slice_table[3][hi & 0xFFu] ^ slice_table[2][(hi >> 8) & 0xFFu] ^
+              slice_table[1][(hi >> 16) & 0xFFu] ^ slice_table[0][hi >> 24];
+    }
+    for (; i < size; i++) {
+        crc = (crc >> 8) ^ slice_table[0][(crc ^ p[i]) & 0xFFu];
+    }
+    return crc;
+}
+
+static uint8_t xor_scalar(const uint8_t *p, size_t size) {
+    uint64_t acc0 = 0;
+    uint64_t acc1 = 0;
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        acc0 ^= load_word(p + i);
+        acc1 ^= load_word(p + i + 8);
+    }
+    if (i + 8 <= size) {
+        acc0 ^= load_word(p + i);
+        i += 8;
+    }
+    uint64_t word = acc0 ^ acc1;
+    word ^= word >> 32;
+    word ^= word >> 16;
+    word ^= word >> 8;
+    uint8_t result = (uint8_t)word;
+    for (; i < size; i++) {
+        result ^= p[i];
+    }
+    return result;
+}
+
+/* Sum of the four 16-bit lanes */
+static inline uint64_t fold_lanes16(uint64_t lanes) {
+    return (lanes & 0xFFFFu) + ((lanes >> 16) & 0xFFFFu) + ((lanes >> 32) & 0xFFFFu) +
+           (lanes >> 48);
+}
+
+static uint64_t sum_scalar(const uint8_t *p, size_t size) {
+    const uint64_t even_bytes = 0x00FF00FF00FF00FFull;
+    uint64_t total = 0;
+    size_t i = 0;
+    while (i + 8 <= size) {
+        // Pairs of bytes added into 16-bit lanes, flushed before they overflow
+        uint64_t lanes = 0;
+        for (size_t n = 0; n < SUM_FLUSH_WORDS && i + 8 <= size; n++, i += 8) {
+            uint64_t word = load_word(p + i);
+            lanes += (word & even_bytes) + ((word >> 8) & even_bytes);
+        }
+        total += fold_lanes16(lanes);
+    }
+    for (; i < size; i++) {
+        total += p[i];
+    }
+    return total;
+}
+
+// ============================================
+// SIMD KERNELS
+// ============================================
+
+#if CHECKSUM_HAVE_SIMD_PATH
+
+static inline uint32_t shift_lane(uint32_t crc) {
+    return lane_shift_table[0][crc & 0xFFu] ^ lane_shift_table[1][(crc >> 8) & 0xFFu] ^
+           lane_shift_table[2][(crc >> 16) & 0xFFu] ^ lane_shift_table[3][crc >> 24];
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2")))
+static inline uint32_t crc32c_word(uint32_t crc, const uint8_t *p) {
+    return (uint32_t)_mm_crc32_u64(crc, load_word(p));
+}
+#else
+__attribute__((target("sse4.2")))
+static inline uint32_t crc32c_word(uint32_t crc, const uint8_t *p) {
+    crc = _mm_crc32_u32(crc, load_le32(p));
+    return _mm_crc32_u32(crc, load_le32(p + 4));
+}
+#endif
+
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_sse42(uint32_t crc, const uint8_t *p, size_t size) {
+    const size_t block = 3 * CRC32C_LANE_BYTES;
+    size_t i = 0;
+    for (; i + block <= size; i += block) {
+        const uint8_t *lane0 = p + i;
+        const uint8_t *lane1 = lane0 + CRC32C_LANE_BYTES;
+        const uint8_t *lane2 = lane1 + CRC32C_LANE_BYTES;
+        uint32_t crc1 = 0;
+        uint32_t crc2 = 0;
+        for (size_t j = 0; j < CRC32C_LANE_BYTES; j += 8) {
+            crc = crc32c_word(crc, lane0 + j);
+            crc1 = crc32c_word(crc1, lane1 + j);
+            crc2 = crc32c_word(crc2, lane2 + j);
+        }
+        crc = shift_lane(shift_lane(crc) ^ crc1) ^ crc2;
+    }
+    for (; i + 8 <= size; i += 8) {
+        crc = crc32c_word(crc, p + i);
+    }
+    for (; i < size; i++) {
+        crc = _mm_crc32_u8(crc, p[i]);
+    }
+    return crc;
+}
+
+__attribute__((target("avx2")))
+static uint8_t xor_avx2(const uint8_t *p, size_t size) {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        acc0 = _mm256_xor_si256(acc0, _mm256_loadu_si256((const __m256i *)(const void *)(p + i)));
+        acc1 = _mm256_xor_si256(acc1,
+                                _mm256_loadu_si256((const __m256i *)(const void *)(p + i + 32)));
+    }
+
+    uint8_t lanes[32];
+    _mm256_storeu_si256((__m256i *)(void *)lanes, _mm256_xor_si256(acc0, acc1));
+    return xor_scalar(lanes, sizeof(lanes)) ^ xor_scalar(p + i, size - i);
+}
+
+__attribute__((target("avx2")))
+static uint64_t sum_avx2(const uint8_t *p, size_t size) {
+    // SAD against zero: each 8-byte group summed into a 64-bit lane
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        __m256i v0 = _mm256_loadu_si256((const __m256i *)(const void *)(p + i));
+        __m256i v1 = _mm256_loadu_si256((const __m256i *)(const void *)(p + i + 32));
+        acc0 = _mm256_add_epi64(acc0, _mm256_sad_epu8(v0, zero));
+        acc1 = _mm256_add_epi64(acc1, _mm256_sad_epu8(v1, zero));
+    }
+
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)(void *)lanes, _mm256_add_epi64(acc0, acc1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_scalar(p + i, size - i);
+}
+
+#endif /* CHECKSUM_HAVE_SIMD_PATH */
+
+// ============================================
+// PUBLIC API
+// ============================================
+
+uint32_t checksum_crc32c(uint32_t crc, const void *data, size_t size) {
+    assert(data != NULL || size == 0);  // Rule 7
+
+    ensure_tables();
+#if CHECKSUM_HAVE_SIMD_PATH
+    if (cpu_has_sse42()) {
+        return ~crc32c_sse42(~crc, (const uint8_t *)data, size);
+    }
+#endif
+    return ~crc32c_slicing(~crc, (const uint8_t *)data, size);
+}
+
+uint32_t checksum_crc32c_portable(uint32_t crc, const void *data, size_t size) {
+    assert(data != NULL || size == 0);  // Rule 7
+
+    ensure_tables();
+    return ~crc32c_slicing(~crc, (const uint8_t *)data, size);
+}
+
+bool checksum_crc32c_hardware(void) {
+#if CHECKSUM_HAVE_SIMD_PATH
+    return cpu_has_sse42();
+#else
+    return false;
+#endif
+}
+
+uint8_t checksum_xor8(const void *data, size_t size) {
+    assert(data != NULL || size == 0);  // Rule 7
+
+#if CHECKSUM_HAVE_SIMD_PATH
+    if (cpu_has_avx2()) {
+        return xor_avx2((const uint8_t *)data, size);
+    }
+#endif
+    return xor_scalar((const uint8_t *)data, size);
+}
+
+uint32_t checksum_sum8(const void *data, size_t size) {
+    assert(data != NULL || size == 0);  // Rule 7
+
+#if CHECKSUM_HAVE_SIMD_PATH
+    if (cpu_has_avx2()) {
+        return (uint32_t)sum_avx2((const uint8_t *)data, size);
+    }
+#endif
+    return (uint32_t)sum_scalar((const uint8_t *)data, size);
+}
@@ -0,0 +1,168 @@
+/*
+ * CLOCK SOURCE - Implementation
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "clock_source.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#else
+#define HAVE_TSC 0
+#endif
+
+#ifndef CLOCK_MONOTONIC_COARSE
+#define CLOCK_MONOTONIC_COARSE CLOCK_MONOTONIC
+#endif
+
+#define NS_PER_SECOND 1000000000ull
+#define CALIBRATION_NS 10000000ull       // 10 ms against CLOCK_MONOTONIC
+#define CALIBRATION_MAX_READS 100000000  // Rule 2: bound the busy wait
+#define TSC_SHIFT 32
+
+__extension__ typedef unsigned __int128 uint128;
+
+/* Shared by every ClockSource; written once by calibrate() */
+static struct {
+    bool done;
+    bool tsc_ok;
+    uint64_t tsc_base;
+    uint64_t ns_base;
+    uint64_t ns_per_tick;  /* Fixed point, TSC_SHIFT fractional bits */
+    int64_t unix_offset_ns;
+} g_calibration;
+
+static uint64_t read_clock(clockid_t id) {
+    struct timespec ts;
+    int rc = clock_gettime(id, &ts);
+    assert(rc == 0);
+    (void)rc;
+    return (uint64_t)ts.tv_sec * NS_PER_SECOND + (uint64_t)ts.tv_nsec;
+}
+
+#if HAVE_TSC
+static bool invariant_tsc(void) {
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return (edx & (1u << 8)) != 0;  // Constant rate across P/C-states
+}
+
+static bool calibrate_tsc(void) {
+    if (!invariant_tsc()) {
+        return false;
+    }
+
+    uint64_t ns0 = read_clock(CLOCK_MONOTONIC);
+    uint64_t tsc0 = __rdtsc();
+    uint64_t ns1 = ns0;
+    for (long i = 0; i < CALIBRATION_MAX_READS && ns1 - ns0 < CALIBRATION_NS; i++) {
+        ns1 = read_clock(CLOCK_MONOTONIC);
+    }
+    uint64_t tsc1 = __rdtsc();
+
+    uint64_t ticks = tsc1 - tsc0;
+    uint64_t elapsed = ns1 - ns0;
+    if (elapsed < CALIBRATION_NS || ticks < elapsed / 16) {
+        return false;  // Clock stuck or TSC slower than 62.5 MHz
+    }
+
+    g_calibration.ns_per_tick = (elapsed << TSC_SHIFT) / ticks;
+    g_calibration.tsc_base = tsc1;
+    g_calibration.ns_base = ns1;
+    return true;
+}
+
+static uint64_t read_tsc_ns(void) {
+    uint64_t ticks = __rdtsc() - g_calibration.tsc_base;
+    uint128 scaled = (uint128)ticks * g_calibration.ns_per_tick;
+    return g_calibration.ns_base + (uint64_t)(scaled >> TSC_SHIFT);
+}
+#else
+static bool calibrate_tsc(void) {
+    return false;
+}
+
+static uint64_t read_tsc_ns(void) {
+    return read_clock(CLOCK_MONOTONIC);
+}
+#endif
+
+static void calibrate(void) {
+    if (g_calibration.done) {
+        return;
+    }
+    g_calibration.tsc_ok = calibrate_tsc();
+
+    uint64_t mono = read_clock(CLOCK_MONOTONIC);
+    uint64_t real = read_clock(CLOCK_REALTIME);
+    g_calibration.unix_offset_ns = (int64_t)(real - mono);
+    g_calibration.done = true;
+}
+
+bool clock_source_init(ClockSource *clock, ClockSourceKind kind) {
+    assert(clock != NULL);
+
+    calibrate();
+    clock->kind = kind;
+    if (kind == CLOCK_SOURCE_TSC && !g_calibration.tsc_ok) {
+        clock->kind = CLOCK_SOURCE_MONOTONIC;
+    }
+    clock->cached_ns = 0;
+    if (kind == CLOCK_SOURCE_CACHED) {
+        (void)clock_source_refresh(clock);
+    }
+    return clock->kind == kind;
+}
+
+uint64_t clock_source_now(ClockSource *clock) {
+    assert(clock != NULL);
+
+    switch (clock->kind) {
+    case CLOCK_SOURCE_TSC:
+        return read_tsc_ns();
+    case CLOCK_SOURCE_COARSE:
+        return read_clock(CLOCK_MONOTONIC_COARSE);
+    case CLOCK_SOURCE_CACHED:
+        return clock->cached_ns;
+    case CLOCK_SOURCE_MONOTONIC:
+    default:
+        return read_clock(CLOCK_MONOTONIC);
+    }
+}
+
+uint64_t clock_source_refresh(ClockSource *clock) {
+    assert(clock != NULL);
+    assert(g_calibration.done);  // Rule 7: clock_source_init ran
+
+    clock->cached_ns = g_calibration.tsc_ok ? read_tsc_ns() : read_clock(CLOCK_MONOTONIC);
+    return clock->cached_ns;
+}
+
+uint32_t clock_source_unix_seconds(uint64_t monotonic_ns) {
+    assert(g_calibration.done);
+    return (uint32_t)((monotonic_ns + (uint64_t)g_calibration.unix_offset_ns) / NS_PER_SECOND);
+}
+
+bool clock_source_tsc_available(void) {
+    calibrate();
+    return g_calibration.tsc_ok;
+}
+
+const char *clock_source_name(ClockSourceKind kind) {
+    switch (kind) {
+    case CLOCK_SOURCE_MONOTONIC: return "monotonic";
+    case CLOCK_SOURCE_TSC:       return "tsc";
+    case CLOCK_SOURCE_COARSE:    return "coarse";
+    case CLOCK_SOURCE_CACHED:    return "cached";
+    default:                     return "unknown";
+    }
+}
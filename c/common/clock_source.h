@@ -0,0 +1,59 @@
+/*
+ * CLOCK SOURCE - Cheap monotonic nanosecond timestamps
+ *
+ * Every source returns nanoseconds on the CLOCK_MONOTONIC time base, so
+ * timestamps from different subsystems can be compared. Each subsystem
+ * owns a ClockSource and picks the cost/resolution trade-off it needs:
+ *
+ *   CLOCK_SOURCE_MONOTONIC  clock_gettime(CLOCK_MONOTONIC), ns resolution
+ *   CLOCK_SOURCE_TSC        rdtsc scaled by a multiplier calibrated once
+ *                           against CLOCK_MONOTONIC; ns resolution, no
+ *                           vDSO call. Falls back to MONOTONIC when the
+ *                           CPU has no invariant TSC.
+ *   CLOCK_SOURCE_COARSE     CLOCK_MONOTONIC_COARSE, kernel tick (1-4 ms)
+ *   CLOCK_SOURCE_CACHED     the value stored by clock_source_refresh();
+ *                           one precise read per batch, free per sample
+ *
+ * The first clock_source_init() calibrates the TSC (~10 ms busy wait);
+ * call it from the startup thread before sharing sources.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c clock_source.c
+ */
+
+#ifndef CLOCK_SOURCE_H
+#define CLOCK_SOURCE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum {
+    CLOCK_SOURCE_MONOTONIC = 0,
+    CLOCK_SOURCE_TSC,
+    CLOCK_SOURCE_COARSE,
+    CLOCK_SOURCE_CACHED
+} ClockSourceKind;
+
+typedef struct {
+    ClockSourceKind kind;
+    uint64_t cached_ns;  /* CLOCK_SOURCE_CACHED: value of the last refresh */
+} ClockSource;
+
+/* Select a source. Returns false (and uses MONOTONIC) if TSC is unusable */
+bool clock_source_init(ClockSource *clock, ClockSourceKind kind);
+
+/* Current time in nanoseconds on the monotonic time base */
+uint64_t clock_source_now(ClockSource *clock);
+
+/* Take one precise reading (TSC when available) and cache it */
+uint64_t clock_source_refresh(ClockSource *clock);
+
+/* Unix time in seconds of a timestamp returned by clock_source_now */
+uint32_t clock_source_unix_seconds(uint64_t monotonic_ns);
+
+/* Whether TSC readings are used for CLOCK_SOURCE_TSC */
+bool clock_source_tsc_available(void);
+
+/* Printable name of a source kind */
+const char *clock_source_name(ClockSourceKind kind);
+
+#endif /* CLOCK_SOURCE_H */
@@ -0,0 +1,55 @@
+/*
+ * CPU FEATURES - Implementation
+ *
+ * One word holds the feature bits plus a ready bit. Relaxed ordering is
+ * enough: the word is the only shared state, and it is written whole.
+ */
+
+#include "cpu_features.h"
+
+#include <stdatomic.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_FEATURES_HAVE_X86 1
+#else
+#define CPU_FEATURES_HAVE_X86 0
+#endif
+
+#define FEATURE_SSE42 (1u << 0)
+#define FEATURE_AVX2 (1u << 1)
+#define FEATURE_F16C (1u << 2)
+#define FEATURES_READY (1u << 31)  // Never 0 once detected
+
+static _Atomic unsigned features;
+
+static unsigned detect_features(void) {
+    unsigned found = FEATURES_READY;
+#if CPU_FEATURES_HAVE_X86
+    __builtin_cpu_init();
+    found |= __builtin_cpu_supports("sse4.2") ? FEATURE_SSE42 : 0u;
+    found |= __builtin_cpu_supports("avx2") ? FEATURE_AVX2 : 0u;
+    found |= __builtin_cpu_supports("f16c") ? FEATURE_F16C : 0u;
+#endif
+    return found;
+}
+
+static bool has_feature(unsigned feature) {
+    unsigned bits = atomic_load_explicit(&features, memory_order_relaxed);
+    if (bits == 0) {
+        bits = detect_features();
+        atomic_store_explicit(&features, bits, memory_order_relaxed);
+    }
+    return (bits & feature) != 0;
+}
+
+bool cpu_has_sse42(void) {
+    return has_feature(FEATURE_SSE42);
+}
+
+bool cpu_has_avx2(void) {
+    return has_feature(FEATURE_AVX2);
+}
+
+bool cpu_has_f16c(void) {
+    return has_feature(FEATURE_F16C);
+}
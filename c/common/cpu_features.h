@@ -0,0 +1,28 @@
+/*
+ * CPU FEATURES - Runtime detection of the x86 extensions the kernels use
+ *
+ * Every SIMD kernel of common/ and telemetry/ dispatches on these
+ * instead of keeping its own cached check. The CPU is queried by one
+ * init on the first call and the result is published through an atomic,
+ * so any thread may call them at any time (threads racing on the first
+ * call store the same bits). Off x86, or without the GCC builtins, every
+ * feature reads as absent and the scalar paths are used.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c cpu_features.c
+ */
+
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#include <stdbool.h>
+
+/* SSE4.2: the crc32 instruction */
+bool cpu_has_sse42(void);
+
+/* AVX2: 256-bit integer vectors, gathers */
+bool cpu_has_avx2(void);
+
+/* F16C: float16 <-> float conversions */
+bool cpu_has_f16c(void);
+
+#endif /* CPU_FEATURES_H */
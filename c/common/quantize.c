@@ -0,0 +1,212 @@
+/*
+ * QUANTIZE - Implementation
+ *
+ * The SIMD and scalar decoders perform the same IEEE operations in the
+ * same order (exact int16 -> float or half -> float conversion, then one
+ * multiply and one add, no FMA), so both give identical results.
+ */
+
+#include "quantize.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "cpu_features.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define QUANTIZE_HAVE_SIMD_PATH 1
+#include <immintrin.h>
+#else
+#define QUANTIZE_HAVE_SIMD_PATH 0
+#endif
+
+#define INT16_CODE_MAX 32767
+
+// ============================================
+// BINARY16
+// ============================================
+
+uint16_t float_to_half(float value) {
+    uint32_t x;
+    memcpy(&x, &value, sizeof(x));
+    uint32_t sign = (x >> 16) & 0x8000u;
+    uint32_t abs = x & 0x7FFFFFFFu;
+
+    if (abs >= 0x7F800000u) {
+        return (uint16_t)(sign | ((abs > 0x7F800000u) ? 0x7E00u : 0x7C00u));  // NaN / inf
+    }
+    if (abs >= 0x477FF000u) {
+        return (uint16_t)(sign | 0x7C00u);  // >= 65520 rounds to inf
+    }
+    if (abs < 0x38800000u) {
+        // Below 2^-14: subnormal half, units of 2^-24
+        if (abs < 0x33000000u) {
+            return (uint16_t)sign;  // Below 2^-25 rounds to zero
+        }
+        uint32_t mantissa = (abs & 0x7FFFFFu) | 0x800000u;
+        uint32_t shift = 126u - (abs >> 23);  // 14..24
+        uint32_t code = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1u);
+        if (rest > halfway || (rest == halfway && (code & 1u))) {
+            code++;  // May carry into the smallest normal: still correct
+        }
+        return (uint16_t)(sign | code);
+    }
+
+    // Normal: rebias the exponent (127 -> 15), keep 10 mantissa bits
+    uint32_t code = (abs - 0x38000000u) >> 13;
+    uint32_t rest = abs & 0x1FFFu;
+    if (rest > 0x1000u || (rest == 0x1000u && (code & 1u))) {
+        code++;  // A carry into the exponent is the right rounding
+    }
+    return (uint16_t)(sign | code);
+}
+
+float half_to_float(uint16_t bits) {
+    uint32_t sign = (uint32_t)(bits & 0x8000u) << 16;
+    uint32_t exponent = (bits >> 10) & 0x1Fu;
+    uint32_t mantissa = bits & 0x3FFu;
+    uint32_t x;
+
+    if (exponent == 0) {
+        float magnitude = (float)mantissa * 0x1p-24f;  // Exact
+        memcpy(&x, &magnitude, sizeof(x));
+        x |= sign;
+    } else if (exponent == 31) {
+        x = sign | 0x7F800000u | (mantissa << 13);
+    } else {
+        x = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    memcpy(&value, &x, sizeof(value));
+    return value;
+}
+
+// ============================================
+// SCALAR DECODERS
+// ============================================
+
+static void dequantize_int16_scalar(const int16_t *codes, size_t count, float scale,
+                                    float offset, float *out) {
+    for (size_t i = 0; i < count; i++) {
+        float step = (float)codes[i] * scale;  // Separate roundings, as the SIMD path
+        out[i] = step + offset;
+    }
+}
+
+static void dequantize_float16_scalar(const uint16_t *codes, size_t count, float offset,
+                                      float *out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = half_to_float(codes[i]) + offset;
+    }
+}
+
+// ============================================
+// SIMD DECODERS
+// ============================================
+
+#if QUANTIZE_HAVE_SIMD_PATH
+
+__attribute__((target("avx2")))
+static void dequantize_int16_avx2(const int16_t *codes, size_t count, float scale,
+                                  float offset, float *out) {
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 voffset = _mm256_set1_ps(offset);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i packed = _mm_loadu_si128((const __m128i *)(const void *)(codes + i));
+        __m256 wide = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(packed));
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(wide, vscale), voffset));
+    }
+    dequantize_int16_scalar(codes + i, count - i, scale, offset, out + i);
+}
+
+__attribute__((target("avx2,f16c")))
+static void dequantize_float16_f16c(const uint16_t *codes, size_t count, float offset,
+                                    float *out) {
+    const __m256 voffset = _mm256_set1_ps(offset);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i packed = _mm_loadu_si128((const __m128i *)(const void *)(codes + i));
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_cvtph_ps(packed), voffset));
+    }
+    dequantize_float16_scalar(codes + i, count - i, offset, out + i);
+}
+
+#endif /* QUANTIZE_HAVE_SIMD_PATH */
+
+// ============================================
+// PUBLIC API
+// ============================================
+
+QuantizeInt16 quantize_int16_params(double min, double max) {
+    assert(min <= max);
+
+    QuantizeInt16 params;
+    params.offset = (float)(min + (max - min) / 2.0);
+    // Half-range around the rounded offset; the scale rounds up so that
+    // +-32767 steps reach both ends and no code needs clamping
+    double above = max - (double)params.offset;
+    double below = (double)params.offset - min;
+    double half = (above > below) ? above : below;
+    if (!(half > 0.0)) {
+        params.scale = 1.0f;  // A constant block still needs a nonzero step
+        return params;
+    }
+    params.scale = (float)(half / INT16_CODE_MAX);
+    if ((double)params.scale * INT16_CODE_MAX < half) {
+        uint32_t bits;
+        memcpy(&bits, &params.scale, sizeof(bits));
+        bits++;  // Next float up (positive, finite)
+        memcpy(&params.scale, &bits, sizeof(bits));
+    }
+    return params;
+}
+
+void quantize_int16(const double *values, size_t count, QuantizeInt16 params, int16_t *out) {
+    assert((values != NULL && out != NULL) || count == 0);
+
+    // Rounded against the stored float scale/offset: the decoder's values
+    for (size_t i = 0; i < count; i++) {
+        double t = (values[i] - (double)params.offset) / (double)params.scale;
+        t = (t < 0.0) ? t - 0.5 : t + 0.5;
+        t = (t > INT16_CODE_MAX) ? INT16_CODE_MAX : t;
+        t = (t < -INT16_CODE_MAX) ? -INT16_CODE_MAX : t;
+        out[i] = (int16_t)t;  // Truncation after +-0.5: round half away
+    }
+}
+
+void dequantize_int16(const int16_t *codes, size_t count, QuantizeInt16 params, float *out) {
+    assert((codes != NULL && out != NULL) || count == 0);
+
+#if QUANTIZE_HAVE_SIMD_PATH
+    if (cpu_has_avx2()) {
+        dequantize_int16_avx2(codes, count, params.scale, params.offset, out);
+        return;
+    }
+#endif
+    dequantize_int16_scalar(codes, count, params.scale, params.offset, out);
+}
+
+void quantize_float16(const double *values, size_t count, float offset, uint16_t *out) {
+    assert((values != NULL && out != NULL) || count == 0);
+
+    for (size_t i = 0; i < count; i++) {
+        out[i] = float_to_half((float)(values[i] - (double)offset));
+    }
+}
+
+void dequantize_float16(const uint16_t *codes, size_t count, float offset, float *out) {
+    assert((codes != NULL && out != NULL) || count == 0);
+
+#if QUANTIZE_HAVE_SIMD_PATH
+    if (cpu_has_avx2() && cpu_has_f16c()) {
+        dequantize_float16_f16c(codes, count, offset, out);
+        return;
+    }
+#endif
+    dequantize_float16_scalar(codes, count, offset, out);
+}
@@ -0,0 +1,53 @@
+/*
+ * QUANTIZE - int16 / float16 encodings of double columns
+ *
+ * Two compact encodings for a block of values with a known range:
+ *
+ *   int16    q = round((x - offset) / scale), |q| <= 32767, with
+ *            offset = block midpoint and scale ~ range / 65534.
+ *            Error bound: scale / 2 + 2^-24 (|x - offset| + |x|) (half a
+ *            step, plus the two float roundings of the decode).
+ *   float16  IEEE binary16 of (x - offset). Error bound:
+ *            2^-11 |x - offset| + 2^-25 + 2^-24 |x|. Finer than int16
+ *            near the offset, coarser at the ends of a wide range;
+ *            requires |x - offset| < 65520.
+ *
+ * Decoding to float is the analytics path: AVX2 (int16) and F16C
+ * (float16) kernels chosen at runtime, 8 values per instruction, with
+ * scalar fallbacks that produce identical bits. Encoding runs once per
+ * block and stays scalar.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c quantize.c
+ */
+
+#ifndef QUANTIZE_H
+#define QUANTIZE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    float scale;
+    float offset;
+} QuantizeInt16;
+
+/* Parameters covering [min, max] (finite, min <= max) */
+QuantizeInt16 quantize_int16_params(double min, double max);
+
+/* Encode count finite values; codes outside +-32767 are clamped */
+void quantize_int16(const double *values, size_t count, QuantizeInt16 params, int16_t *out);
+
+/* out[i] = codes[i] * scale + offset */
+void dequantize_int16(const int16_t *codes, size_t count, QuantizeInt16 params, float *out);
+
+/* IEEE binary16 conversions, round to nearest even */
+uint16_t float_to_half(float value);
+float half_to_float(uint16_t bits);
+
+/* Encode count values as binary16 of (value - offset) */
+void quantize_float16(const double *values, size_t count, float offset, uint16_t *out);
+
+/* out[i] = half(codes[i]) + offset */
+void dequantize_float16(const uint16_t *codes, size_t count, float offset, float *out);
+
+#endif /* QUANTIZE_H */
@@ -0,0 +1,348 @@
+/*
+ * REDUCE - Implementation
+ *
+ * Compensated sums use Neumaier's variant of Kahan summation: the
+ * rounding error of every addition is recovered exactly and kept in a
+ * separate compensation term, whichever operand is larger. The AVX2 path
+ * keeps two independent (sum, compensation) lane pairs to hide the add
+ * latency and folds the eight lanes with the scalar step at the end.
+ */
+
+#include "reduce.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
+
+#include "cpu_features.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define REDUCE_HAVE_AVX2_PATH 1
+#include <immintrin.h>
+#else
+#define REDUCE_HAVE_AVX2_PATH 0
+#endif
+
+#define REDUCE_MAX_STRIDE (INT32_MAX / 8)  // Gather offsets are int32
+
+_Static_assert(sizeof(int) == sizeof(int32_t), "AVX2 int kernels assume 32-bit int");
+
+// ============================================
+// SCALAR KERNELS
+// ============================================
+
+typedef struct {
+    double sum;
+    double compensation;
+} CompensatedSum;
+
+static inline void neumaier_add(CompensatedSum *acc, double x) {
+    double t = acc->sum + x;
+    double abs_sum = (acc->sum >= 0.0) ? acc->sum : -acc->sum;
+    double abs_x = (x >= 0.0) ? x : -x;
+    if (abs_sum >= abs_x) {
+        acc->compensation += (acc->sum - t) + x;
+    } else {
+        acc->compensation += (x - t) + acc->sum;
+    }
+    acc->sum = t;
+}
+
+static inline double neumaier_result(const CompensatedSum *acc) {
+    // inf - inf poisons the compensation: an overflowed sum stands alone
+    return isfinite(acc->sum) ? acc->sum + acc->compensation : acc->sum;
+}
+
+static int64_t sum_int_scalar(const int *values, size_t count) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+static void min_max_int_scalar(const int *values, size_t count, int *min, int *max) {
+    for (size_t i = 0; i < count; i++) {
+        if (values[i] < *min) *min = values[i];
+        if (values[i] > *max) *max = values[i];
+    }
+}
+
+static void sum_double_scalar(const double *values, size_t count, CompensatedSum *acc) {
+    for (size_t i = 0; i < count; i++) {
+        neumaier_add(acc, values[i]);
+    }
+}
+
+static void min_max_double_scalar(const double *values, size_t count, double *min, double *max) {
+    for (size_t i = 0; i < count; i++) {
+        if (values[i] < *min) *min = values[i];
+        if (values[i] > *max) *max = values[i];
+    }
+}
+
+static double sum_float_scalar(const char *first, size_t count, size_t stride) {
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += *(const float *)(const void *)(first + i * stride);
+    }
+    return sum;
+}
+
+/* Sums of (x - mean) and (x - mean)^2 */
+static void deviations_scalar(const double *values, size_t count, double mean,
+                              double *deviation, CompensatedSum *squares) {
+    for (size_t i = 0; i < count; i++) {
+        double d = values[i] - mean;
+        *deviation += d;
+        neumaier_add(squares, d * d);
+    }
+}
+
+// ============================================
+// AVX2 KERNELS
+// ============================================
+
+#if REDUCE_HAVE_AVX2_PATH
+
+__attribute__((target("avx2")))
+static inline void neumaier_add_avx2(__m256d *sum, __m256d *compensation, __m256d x) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d t = _mm256_add_pd(*sum, x);
+    __m256d sum_larger = _mm256_cmp_pd(_mm256_andnot_pd(sign, *sum),
+                                       _mm256_andnot_pd(sign, x), _CMP_GE_OQ);
+    __m256d big = _mm256_blendv_pd(x, *sum, sum_larger);
+    __m256d small = _mm256_blendv_pd(*sum, x, sum_larger);
+    *compensation = _mm256_add_pd(*compensation, _mm256_add_pd(_mm256_sub_pd(big, t), small));
+    *sum = t;
+}
+
+__attribute__((target("avx2")))
+static void fold_lanes(__m256d sum, __m256d compensation, CompensatedSum *acc) {
+    double sums[4];
+    double compensations[4];
+    _mm256_storeu_pd(sums, sum);
+    _mm256_storeu_pd(compensations, compensation);
+    for (int lane = 0; lane < 4; lane++) {
+        neumaier_add(acc, sums[lane]);
+        acc->compensation += compensations[lane];
+    }
+}
+
+__attribute__((target("avx2")))
+static int64_t sum_int_avx2(const int *values, size_t count) {
+    __m256i acc_lo = _mm256_setzero_si256();
+    __m256i acc_hi = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(values + i));
+        acc_lo = _mm256_add_epi64(acc_lo, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        acc_hi = _mm256_add_epi64(acc_hi, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi64(acc_lo, acc_hi));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_int_scalar(values + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void min_max_int_avx2(const int *values, size_t count, int *min, int *max) {
+    __m256i vmin = _mm256_set1_epi32(*min);
+    __m256i vmax = _mm256_set1_epi32(*max);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(values + i));
+        vmin = _mm256_min_epi32(vmin, v);
+        vmax = _mm256_max_epi32(vmax, v);
+    }
+
+    int mins[8];
+    int maxs[8];
+    _mm256_storeu_si256((__m256i *)mins, vmin);
+    _mm256_storeu_si256((__m256i *)maxs, vmax);
+    min_max_int_scalar(mins, 8, min, max);
+    min_max_int_scalar(maxs, 8, min, max);
+    min_max_int_scalar(values + i, count - i, min, max);
+}
+
+__attribute__((target("avx2")))
+static void sum_double_avx2(const double *values, size_t count, CompensatedSum *acc) {
+    __m256d sum0 = _mm256_setzero_pd();
+    __m256d comp0 = _mm256_setzero_pd();
+    __m256d sum1 = _mm256_setzero_pd();
+    __m256d comp1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        neumaier_add_avx2(&sum0, &comp0, _mm256_loadu_pd(values + i));
+        neumaier_add_avx2(&sum1, &comp1, _mm256_loadu_pd(values + i + 4));
+    }
+    fold_lanes(sum0, comp0, acc);
+    fold_lanes(sum1, comp1, acc);
+    sum_double_scalar(values + i, count - i, acc);
+}
+
+__attribute__((target("avx2")))
+static void min_max_double_avx2(const double *values, size_t count, double *min, double *max) {
+    __m256d vmin = _mm256_set1_pd(*min);
+    __m256d vmax = _mm256_set1_pd(*max);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d v = _mm256_loadu_pd(values + i);
+        vmin = _mm256_min_pd(vmin, v);
+        vmax = _mm256_max_pd(vmax, v);
+    }
+
+    double mins[4];
+    double maxs[4];
+    _mm256_storeu_pd(mins, vmin);
+    _mm256_storeu_pd(maxs, vmax);
+    min_max_double_scalar(mins, 4, min, max);
+    min_max_double_scalar(maxs, 4, min, max);
+    min_max_double_scalar(values + i, count - i, min, max);
+}
+
+/* Eight floats widened to double: contiguous loads or one gather */
+__attribute__((target("avx2")))
+static double sum_float_avx2(const char *first, size_t count, size_t stride) {
+    const __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                               _mm256_set1_epi32((int)stride));
+    __m256d acc_lo = _mm256_setzero_pd();
+    __m256d acc_hi = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const char *base = first + i * stride;
+        __m256 v = (stride == sizeof(float))
+                       ? _mm256_loadu_ps((const float *)(const void *)base)
+                       : _mm256_i32gather_ps((const float *)(const void *)base, offsets, 1);
+        acc_lo = _mm256_add_pd(acc_lo, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+        acc_hi = _mm256_add_pd(acc_hi, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc_lo, acc_hi));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+           sum_float_scalar(first + i * stride, count - i, stride);
+}
+
+__attribute__((target("avx2")))
+static void deviations_avx2(const double *values, size_t count, double mean,
+                            double *deviation, CompensatedSum *squares) {
+    const __m256d vmean = _mm256_set1_pd(mean);
+    __m256d dev = _mm256_setzero_pd();
+    __m256d sq_sum = _mm256_setzero_pd();
+    __m256d sq_comp = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d d = _mm256_sub_pd(_mm256_loadu_pd(values + i), vmean);
+        dev = _mm256_add_pd(dev, d);
+        neumaier_add_avx2(&sq_sum, &sq_comp, _mm256_mul_pd(d, d));
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, dev);
+    *deviation += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    fold_lanes(sq_sum, sq_comp, squares);
+    deviations_scalar(values + i, count - i, mean, deviation, squares);
+}
+
+#endif /* REDUCE_HAVE_AVX2_PATH */
+
+// ============================================
+// PUBLIC API
+// ============================================
+
+int64_t reduce_sum_int(const int *values, size_t count) {
+    assert(values != NULL || count == 0);
+    assert((uint64_t)count <= UINT32_MAX);  // Rule 7: |sum| < 2^63
+
+#if REDUCE_HAVE_AVX2_PATH
+    if (cpu_has_avx2()) {
+        return sum_int_avx2(values, count);
+    }
+#endif
+    return sum_int_scalar(values, count);
+}
+
+void reduce_min_max_int(const int *values, size_t count, int *min, int *max) {
+    assert(values != NULL && count > 0);
+    assert(min != NULL && max != NULL);
+
+    *min = values[0];
+    *max = values[0];
+#if REDUCE_HAVE_AVX2_PATH
+    if (cpu_has_avx2()) {
+        min_max_int_avx2(values, count, min, max);
+        return;
+    }
+#endif
+    min_max_int_scalar(values, count, min, max);
+}
+
+double reduce_sum_double(const double *values, size_t count) {
+    assert(values != NULL || count == 0);
+
+    CompensatedSum acc = {0.0, 0.0};
+#if REDUCE_HAVE_AVX2_PATH
+    if (cpu_has_avx2()) {
+        sum_double_avx2(values, count, &acc);
+        return neumaier_result(&acc);
+    }
+#endif
+    sum_double_scalar(values, count, &acc);
+    return neumaier_result(&acc);
+}
+
+void reduce_min_max_double(const double *values, size_t count, double *min, double *max) {
+    assert(values != NULL && count > 0);
+    assert(min != NULL && max != NULL);
+
+    *min = values[0];
+    *max = values[0];
+#if REDUCE_HAVE_AVX2_PATH
+    if (cpu_has_avx2()) {
+        min_max_double_avx2(values, count, min, max);
+        return;
+    }
+#endif
+    min_max_double_scalar(values, count, min, max);
+}
+
+double reduce_sum_float(const float *first, size_t count, size_t stride) {
+    assert(first != NULL || count == 0);
+    assert(stride >= sizeof(float) && stride % sizeof(float) == 0);
+    assert(stride <= REDUCE_MAX_STRIDE);
+
+#if REDUCE_HAVE_AVX2_PATH
+    if (cpu_has_avx2()) {
+        return sum_float_avx2((const char *)first, count, stride);
+    }
+#endif
+    return sum_float_scalar((const char *)first, count, stride);
+}
+
+void reduce_mean_variance(const double *values, size_t count, double *mean, double *variance) {
+    assert(values != NULL && count > 0);
+    assert(mean != NULL && variance != NULL);
+
+    const double n = (double)count;
+    const double m = reduce_sum_double(values, count) / n;
+
+    // Second pass: the deviation sum is zero in exact arithmetic, so it
+    // measures (and removes) the rounding error of the mean
+    double deviation = 0.0;
+    CompensatedSum squares = {0.0, 0.0};
+#if REDUCE_HAVE_AVX2_PATH
+    if (cpu_has_avx2()) {
+        deviations_avx2(values, count, m, &deviation, &squares);
+    } else {
+        deviations_scalar(values, count, m, &deviation, &squares);
+    }
+#else
+    deviations_scalar(values, count, m, &deviation, &squares);
+#endif
+
+    double v = (neumaier_result(&squares) - deviation * deviation / n) / n;
+    *mean = m;
+    *variance = (v > 0.0) ? v : 0.0;
+}
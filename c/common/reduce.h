@@ -0,0 +1,47 @@
+/*
+ * REDUCE - Sum, min/max and mean/variance kernels
+ *
+ * Aggregates that stay exact (or close to it) over large windows:
+ *
+ *   reduce_sum_int        int32 values accumulated in int64, exact for
+ *                         fewer than 2^32 values
+ *   reduce_sum_double     Neumaier-compensated sum: error independent of
+ *                         the count instead of growing with it
+ *   reduce_sum_float      float fields read with a byte stride (one member
+ *                         of an array of structs), accumulated in double
+ *   reduce_mean_variance  corrected two-pass population variance; never
+ *                         negative, no catastrophic cancellation
+ *
+ * Each kernel has an AVX2 path chosen at runtime (4-8 lanes, lanes folded
+ * once at the end) and a scalar fallback. Lane order differs from a left
+ * to right loop, so double results may differ in the last bit; integer
+ * results are identical. NaN inputs give unspecified min/max results.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c reduce.c
+ */
+
+#ifndef REDUCE_H
+#define REDUCE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exact sum of count ints (count < 2^32) */
+int64_t reduce_sum_int(const int *values, size_t count);
+
+/* Smallest and largest of count > 0 ints */
+void reduce_min_max_int(const int *values, size_t count, int *min, int *max);
+
+/* Compensated sum of count doubles */
+double reduce_sum_double(const double *values, size_t count);
+
+/* Smallest and largest of count > 0 doubles */
+void reduce_min_max_double(const double *values, size_t count, double *min, double *max);
+
+/* Sum of count floats, the i-th at (const char *)first + i * stride bytes */
+double reduce_sum_float(const float *first, size_t count, size_t stride);
+
+/* Mean and population variance (divided by count) of count > 0 doubles */
+void reduce_mean_variance(const double *values, size_t count, double *mean, double *variance);
+
+#endif /* REDUCE_H */
@@ -0,0 +1,162 @@
+/*
+ * SELECTION - Implementation
+ */
+
+#include "selection.h"
+#include "sort_internal.h"
+
+#include <assert.h>
+#include <string.h>
+
+#define SELECT_MAX_RANKS (2 * SELECT_MAX_PERCENTILES)
+
+/* Each pushed entry costs one partition level on the current path */
+#define SELECT_STACK_DEPTH (2 * SORT_STACK_DEPTH + 1)
+
+typedef struct {
+    SortRange range;
+    size_t first_rank;  /* ranks[first_rank..last_rank] lie in range */
+    size_t last_rank;
+} SelectTask;
+
+DEFINE_SORT_PRIMITIVES(int, int)
+DEFINE_SORT_PRIMITIVES(double, double)
+
+/* Index of the first rank in ranks[first..last] that is > pivot_index */
+static size_t split_ranks(const size_t *ranks, size_t first, size_t last,
+                          size_t pivot_index) {
+    size_t i = first;
+    while (i <= last && ranks[i] <= pivot_index) {
+        i++;
+    }
+    return i;
+}
+
+/*
+ * Place every ranks[i] (sorted, unique, < count) at its sorted position.
+ * Ranges that contain no requested rank are never touched again.
+ */
+#define DEFINE_MULTISELECT(SUFFIX, TYPE)                                       \
+static void multiselect_##SUFFIX(TYPE *a, size_t count,                        \
+                                 const size_t *ranks, size_t rank_count) {     \
+    SelectTask stack[SELECT_STACK_DEPTH];                                      \
+    size_t top = 0;                                                            \
+    stack[top++] = (SelectTask){ { 0, count - 1, depth_limit(count) },         \
+                                 0, rank_count - 1 };                          \
+                                                                               \
+    while (top > 0) {                                                          \
+        SelectTask t = stack[--top];                                           \
+        while (t.range.hi - t.range.lo + 1 > SORT_SMALL_RANGE                  \
+               && t.range.depth > 0) {                                         \
+            size_t p = partition_##SUFFIX(a, t.range.lo, t.range.hi);          \
+            size_t split = split_ranks(ranks, t.first_rank, t.last_rank, p);   \
+            t.range.depth--;                                                   \
+            SelectTask left = { { t.range.lo, p, t.range.depth },              \
+                                t.first_rank, split - 1 };                     \
+            SelectTask right = { { p + 1, t.range.hi, t.range.depth },         \
+                                 split, t.last_rank };                         \
+            bool need_left = split > t.first_rank;                             \
+            bool need_right = split <= t.last_rank;                            \
+            if (need_left && need_right) {                                     \
+                assert(top < SELECT_STACK_DEPTH);                              \
+                stack[top++] = right;                                          \
+            }                                                                  \
+            t = need_left ? left : right;                                      \
+        }                                                                      \
+        size_t n = t.range.hi - t.range.lo + 1;                                \
+        if (n <= SORT_SMALL_RANGE) {                                           \
+            insertion_sort_##SUFFIX(a, t.range.lo, t.range.hi);                \
+        } else {                                                               \
+            heap_sort_##SUFFIX(&a[t.range.lo], n);                             \
+        }                                                                      \
+    }                                                                          \
+}
+
+DEFINE_MULTISELECT(int, int)
+DEFINE_MULTISELECT(double, double)
+
+double select_kth(double *data, size_t count, size_t k) {
+    assert(data != NULL);
+    assert(k < count);
+
+    multiselect_double(data, count, &k, 1);
+    return data[k];
+}
+
+int select_kth_int(int *data, size_t count, size_t k) {
+    assert(data != NULL);
+    assert(k < count);
+
+    multiselect_int(data, count, &k, 1);
+    return data[k];
+}
+
+/* Sort the (tiny) rank list and drop duplicates; returns the new length */
+static size_t normalize_ranks(size_t *ranks, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        size_t key = ranks[i];
+        size_t j = i;
+        while (j > 0 && ranks[j - 1] > key) {
+            ranks[j] = ranks[j - 1];
+            j--;
+        }
+        ranks[j] = key;
+    }
+
+    size_t unique = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (unique == 0 || ranks[unique - 1] != ranks[i]) {
+            ranks[unique++] = ranks[i];
+        }
+    }
+    return unique;
+}
+
+bool percentiles(double *data, size_t count,
+                 const double *ps, size_t k, double *out) {
+    if (data == NULL || ps == NULL || out == NULL) {
+        return false;
+    }
+    if (count == 0 || k == 0 || k > SELECT_MAX_PERCENTILES) {
+        return false;
+    }
+
+    size_t ranks[SELECT_MAX_RANKS];
+    size_t rank_count = 0;
+    for (size_t i = 0; i < k; i++) {
+        if (!(ps[i] >= 0.0 && ps[i] <= 100.0)) {
+            return false;  // Also rejects NaN
+        }
+        double position = ps[i] / 100.0 * (double)(count - 1);
+        size_t lower = (size_t)position;
+        ranks[rank_count++] = lower;
+        if (lower + 1 < count) {
+            ranks[rank_count++] = lower + 1;
+        }
+    }
+
+    rank_count = normalize_ranks(ranks, rank_count);
+    multiselect_double(data, count, ranks, rank_count);
+
+    for (size_t i = 0; i < k; i++) {
+        double position = ps[i] / 100.0 * (double)(count - 1);
+        size_t lower = (size_t)position;
+        double fraction = position - (double)lower;
+        out[i] = data[lower];
+        if (fraction > 0.0 && lower + 1 < count) {
+            out[i] += fraction * (data[lower + 1] - data[lower]);
+        }
+    }
+
+    return true;
+}
+
+bool percentiles_copy(const double *data, size_t count, double *scratch,
+                      const double *ps, size_t k, double *out) {
+    if (data == NULL || scratch == NULL) {
+        return false;
+    }
+
+    memcpy(scratch, data, count * sizeof(double));
+    return percentiles(scratch, count, ps, k, out);
+}
@@ -0,0 +1,41 @@
+/*
+ * SELECTION - Linear-time order statistics and batch percentiles
+ *
+ * Introselect: quickselect with median-of-three pivots that falls back
+ * to heapsort on the remaining range after 2*log2(n) partitions, so the
+ * worst case stays O(n log n). Several ranks are resolved in one pass
+ * by only descending into partitions that still contain a requested
+ * rank. No recursion (Rule 1), no allocation (Rule 3).
+ *
+ * The in-place functions reorder data; the *_copy variant works on a
+ * caller-provided scratch buffer and leaves the input untouched.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c selection.c
+ */
+
+#ifndef SELECTION_H
+#define SELECTION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Maximum percentiles per call (each needs up to two ranks) */
+#define SELECT_MAX_PERCENTILES 16
+
+/* Return the k-th smallest element (0-based). Requires k < count. */
+double select_kth(double *data, size_t count, size_t k);
+int select_kth_int(int *data, size_t count, size_t k);
+
+/*
+ * Compute percentiles ps[0..k-1] (each in [0, 100]) into out[0..k-1],
+ * linearly interpolating between the two closest ranks. Returns false
+ * on empty input, k > SELECT_MAX_PERCENTILES or an out-of-range ps.
+ */
+bool percentiles(double *data, size_t count,
+                 const double *ps, size_t k, double *out);
+
+/* Same as percentiles() but data is first copied into scratch[count] */
+bool percentiles_copy(const double *data, size_t count, double *scratch,
+                      const double *ps, size_t k, double *out);
+
+#endif /* SELECTION_H */
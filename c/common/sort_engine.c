@@ -0,0 +1,295 @@
+/*
+ * SORT ENGINE - Implementation
+ *
+ * The scalar introsort is written once as a macro and instantiated for
+ * int and double. The AVX2 sorting networks are selected at runtime so
+ * the same binary runs on CPUs without AVX2.
+ */
+
+#include "sort_engine.h"
+#include "sort_internal.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cpu_features.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SORT_HAVE_AVX2_PATH 1
+#include <immintrin.h>
+#else
+#define SORT_HAVE_AVX2_PATH 0
+#endif
+
+/* Sorting networks are only worth it for ranges in [8, 16] */
+#define SORT_NETWORK_MIN 8
+#define SORT_NETWORK_LANES 16
+#define SORT_NETWORK_LAYERS 10
+
+// ============================================
+// SIMD SORTING NETWORK (16-input bitonic)
+// ============================================
+
+#if SORT_HAVE_AVX2_PATH
+
+/* Compare distance of each layer, stages k = 2, 4, 8, 16 */
+static const int network_distance[SORT_NETWORK_LAYERS] = {
+    1, 2, 1, 4, 2, 1, 8, 4, 2, 1
+};
+
+/* -1 where lane i keeps max(v[i], v[i ^ distance]), 0 where it keeps min */
+static const int32_t network_keep_max[SORT_NETWORK_LAYERS][SORT_NETWORK_LANES] = {
+    { 0, -1, -1,  0,  0, -1, -1,  0,  0, -1, -1,  0,  0, -1, -1,  0 },
+    { 0,  0, -1, -1, -1, -1,  0,  0,  0,  0, -1, -1, -1, -1,  0,  0 },
+    { 0, -1,  0, -1, -1,  0, -1,  0,  0, -1,  0, -1, -1,  0, -1,  0 },
+    { 0,  0,  0,  0, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0,  0,  0 },
+    { 0,  0, -1, -1,  0,  0, -1, -1, -1, -1,  0,  0, -1, -1,  0,  0 },
+    { 0, -1,  0, -1,  0, -1,  0, -1, -1,  0, -1,  0, -1,  0, -1,  0 },
+    { 0,  0,  0,  0,  0,  0,  0,  0, -1, -1, -1, -1, -1, -1, -1, -1 },
+    { 0,  0,  0,  0, -1, -1, -1, -1,  0,  0,  0,  0, -1, -1, -1, -1 },
+    { 0,  0, -1, -1,  0,  0, -1, -1,  0,  0, -1, -1,  0,  0, -1, -1 },
+    { 0, -1,  0, -1,  0, -1,  0, -1,  0, -1,  0, -1,  0, -1,  0, -1 }
+};
+
+/* Lane permutations i -> i ^ distance for distances 1, 2, 4 */
+static const int32_t network_partner[3][8] = {
+    { 1, 0, 3, 2, 5, 4, 7, 6 },
+    { 2, 3, 0, 1, 6, 7, 4, 5 },
+    { 4, 5, 6, 7, 0, 1, 2, 3 }
+};
+
+static int permute_row(int distance) {
+    return (distance == 1) ? 0 : ((distance == 2) ? 1 : 2);
+}
+
+__attribute__((target("avx2")))
+static void network_sort_int_avx2(int *data, size_t count) {
+    int lanes[SORT_NETWORK_LANES];
+    for (size_t i = 0; i < SORT_NETWORK_LANES; i++) {
+        lanes[i] = (i < count) ? data[i] : INT_MAX;  // Padding sorts last
+    }
+
+    __m256i a = _mm256_loadu_si256((const __m256i *)&lanes[0]);
+    __m256i b = _mm256_loadu_si256((const __m256i *)&lanes[8]);
+
+    for (int layer = 0; layer < SORT_NETWORK_LAYERS; layer++) {
+        const int32_t *keep_max = network_keep_max[layer];
+        __m256i mask_a = _mm256_loadu_si256((const __m256i *)&keep_max[0]);
+        __m256i mask_b = _mm256_loadu_si256((const __m256i *)&keep_max[8]);
+
+        if (network_distance[layer] == 8) {
+            __m256i lo = _mm256_min_epi32(a, b);
+            __m256i hi = _mm256_max_epi32(a, b);
+            a = _mm256_blendv_epi8(lo, hi, mask_a);
+            b = _mm256_blendv_epi8(lo, hi, mask_b);
+        } else {
+            const int32_t *row = network_partner[permute_row(network_distance[layer])];
+            __m256i idx = _mm256_loadu_si256((const __m256i *)row);
+            __m256i pa = _mm256_permutevar8x32_epi32(a, idx);
+            __m256i pb = _mm256_permutevar8x32_epi32(b, idx);
+            a = _mm256_blendv_epi8(_mm256_min_epi32(a, pa), _mm256_max_epi32(a, pa), mask_a);
+            b = _mm256_blendv_epi8(_mm256_min_epi32(b, pb), _mm256_max_epi32(b, pb), mask_b);
+        }
+    }
+
+    _mm256_storeu_si256((__m256i *)&lanes[0], a);
+    _mm256_storeu_si256((__m256i *)&lanes[8], b);
+    memcpy(data, lanes, count * sizeof(int));
+}
+
+__attribute__((target("avx2")))
+static __m256d network_mask_pd(const int32_t *keep_max) {
+    __m128i narrow = _mm_loadu_si128((const __m128i *)keep_max);
+    return _mm256_castsi256_pd(_mm256_cvtepi32_epi64(narrow));
+}
+
+__attribute__((target("avx2")))
+static __m256d network_swap_pd(__m256d v, int distance) {
+    return (distance == 1) ? _mm256_permute_pd(v, 0x5)
+                           : _mm256_permute4x64_pd(v, 0x4E);
+}
+
+__attribute__((target("avx2")))
+static void network_sort_double_avx2(double *data, size_t count) {
+    double lanes[SORT_NETWORK_LANES];
+    for (size_t i = 0; i < SORT_NETWORK_LANES; i++) {
+        lanes[i] = (i < count) ? data[i] : HUGE_VAL;
+    }
+
+    __m256d v[4];
+    for (int r = 0; r < 4; r++) {
+        v[r] = _mm256_loadu_pd(&lanes[4 * r]);
+    }
+
+    for (int layer = 0; layer < SORT_NETWORK_LAYERS; layer++) {
+        const int distance = network_distance[layer];
+        const int32_t *keep_max = network_keep_max[layer];
+
+        if (distance < 4) {
+            for (int r = 0; r < 4; r++) {
+                __m256d p = network_swap_pd(v[r], distance);
+                v[r] = _mm256_blendv_pd(_mm256_min_pd(v[r], p), _mm256_max_pd(v[r], p),
+                                        network_mask_pd(&keep_max[4 * r]));
+            }
+            continue;
+        }
+
+        const int step = distance / 4;  // Register distance: 1 or 2
+        for (int r = 0; r < 4; r++) {
+            if ((r & step) != 0) {
+                continue;  // Handled as the partner of r - step
+            }
+            __m256d lo = _mm256_min_pd(v[r], v[r + step]);
+            __m256d hi = _mm256_max_pd(v[r], v[r + step]);
+            v[r] = _mm256_blendv_pd(lo, hi, network_mask_pd(&keep_max[4 * r]));
+            v[r + step] = _mm256_blendv_pd(lo, hi, network_mask_pd(&keep_max[4 * (r + step)]));
+        }
+    }
+
+    for (int r = 0; r < 4; r++) {
+        _mm256_storeu_pd(&lanes[4 * r], v[r]);
+    }
+    memcpy(data, lanes, count * sizeof(double));
+}
+
+#endif /* SORT_HAVE_AVX2_PATH */
+
+// ============================================
+// SCALAR INTROSORT (instantiated per element type)
+// ============================================
+
+#define DEFINE_INTROSORT(SUFFIX, TYPE)                                         \
+static void introsort_##SUFFIX(TYPE *a, size_t count,                          \
+                               void (*small_sort)(TYPE *, size_t)) {           \
+    SortRange stack[SORT_STACK_DEPTH];                                         \
+    size_t top = 0;                                                            \
+    stack[top++] = (SortRange){ 0, count - 1, depth_limit(count) };            \
+                                                                               \
+    while (top > 0) {                                                          \
+        SortRange r = stack[--top];                                            \
+        while (r.hi - r.lo + 1 > SORT_SMALL_RANGE) {                           \
+            if (r.depth == 0) {                                                \
+                heap_sort_##SUFFIX(&a[r.lo], r.hi - r.lo + 1);                 \
+                break;                                                         \
+            }                                                                  \
+            size_t p = partition_##SUFFIX(a, r.lo, r.hi);                      \
+            r.depth--;                                                         \
+            SortRange left = { r.lo, p, r.depth };                             \
+            SortRange right = { p + 1, r.hi, r.depth };                        \
+            /* Push the larger half, keep working on the smaller one */        \
+            bool left_larger = (p - r.lo) > (r.hi - p - 1);                    \
+            assert(top < SORT_STACK_DEPTH);                                    \
+            stack[top++] = left_larger ? left : right;                         \
+            r = left_larger ? right : left;                                    \
+        }                                                                      \
+        if (r.hi - r.lo + 1 <= SORT_SMALL_RANGE) {                             \
+            small_sort(&a[r.lo], r.hi - r.lo + 1);                             \
+        }                                                                      \
+    }                                                                          \
+}
+
+DEFINE_SORT_PRIMITIVES(int, int)
+DEFINE_SORT_PRIMITIVES(double, double)
+DEFINE_INTROSORT(int, int)
+DEFINE_INTROSORT(double, double)
+
+static void small_sort_int(int *a, size_t count) {
+#if SORT_HAVE_AVX2_PATH
+    if (count >= SORT_NETWORK_MIN && cpu_has_avx2()) {
+        network_sort_int_avx2(a, count);
+        return;
+    }
+#endif
+    if (count > 1) {
+        insertion_sort_int(a, 0, count - 1);
+    }
+}
+
+static void small_sort_double(double *a, size_t count) {
+#if SORT_HAVE_AVX2_PATH
+    if (count >= SORT_NETWORK_MIN && cpu_has_avx2()) {
+        network_sort_double_avx2(a, count);
+        return;
+    }
+#endif
+    if (count > 1) {
+        insertion_sort_double(a, 0, count - 1);
+    }
+}
+
+// ============================================
+// PUBLIC API
+// ============================================
+
+void sort_int(int *data, size_t count) {
+    assert(data != NULL || count == 0);
+    if (count < 2) {
+        return;
+    }
+    introsort_int(data, count, small_sort_int);
+}
+
+void sort_double(double *data, size_t count) {
+    assert(data != NULL || count == 0);
+    if (count < 2) {
+        return;
+    }
+    introsort_double(data, count, small_sort_double);
+}
+
+void sort_int_radix(int *data, int *scratch, size_t count) {
+    assert(data != NULL || count == 0);
+    assert(scratch != NULL || count == 0);
+
+    if (count < 2) {
+        return;
+    }
+    size_t histogram[4][256] = {{0}};
+    for (size_t i = 0; i < count; i++) {
+        uint32_t key = (uint32_t)data[i] ^ 0x80000000u;  // Signed order
+        for (int pass = 0; pass < 4; pass++) {
+            histogram[pass][(key >> (8 * pass)) & 0xFF]++;
+        }
+    }
+
+    int *src = data;
+    int *dst = scratch;
+    for (int pass = 0; pass < 4; pass++) {
+        size_t *bucket = histogram[pass];
+        uint32_t first_digit = (((uint32_t)src[0] ^ 0x80000000u) >> (8 * pass)) & 0xFF;
+        if (bucket[first_digit] == count) {
+            continue;  // Every key shares this digit
+        }
+
+        size_t offset = 0;
+        for (int d = 0; d < 256; d++) {
+            size_t n = bucket[d];
+            bucket[d] = offset;
+            offset += n;
+        }
+        for (size_t i = 0; i < count; i++) {
+            uint32_t key = (uint32_t)src[i] ^ 0x80000000u;
+            dst[bucket[(key >> (8 * pass)) & 0xFF]++] = src[i];
+        }
+
+        int *swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != data) {
+        memcpy(data, src, count * sizeof(int));
+    }
+}
+
+void sort_int_with_scratch(int *data, int *scratch, size_t count) {
+    if (scratch != NULL && count >= SORT_RADIX_THRESHOLD) {
+        sort_int_radix(data, scratch, count);
+    } else {
+        sort_int(data, count);
+    }
+}
@@ -0,0 +1,43 @@
+/*
+ * SORT ENGINE - Bounded-stack hybrid sorting for int and double arrays
+ *
+ * Introsort without recursion (Rule 1): quicksort with median-of-three
+ * pivots, a heapsort fallback once the partition depth exceeds
+ * 2*log2(n), and small ranges finished by insertion sort or, on CPUs
+ * with AVX2, by a 16-input bitonic sorting network.
+ *
+ * Large int arrays can use an LSD radix sort instead; it needs a
+ * caller-provided scratch buffer of the same length (Rule 3: no malloc).
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c sort_engine.c
+ */
+
+#ifndef SORT_ENGINE_H
+#define SORT_ENGINE_H
+
+#include <stddef.h>
+
+/* Ranges at or below this size skip partitioning */
+#define SORT_SMALL_RANGE 16
+
+/* Below this size radix sort loses to introsort */
+#define SORT_RADIX_THRESHOLD 1024
+
+/* Explicit stack entries; log2(SIZE_MAX) is enough since the
+ * smaller partition is always processed first */
+#define SORT_STACK_DEPTH 64
+
+/* Sort ascending in place. O(n log n) worst case, O(1) extra memory. */
+void sort_int(int *data, size_t count);
+
+/* Sort ascending in place. Input must not contain NaN. */
+void sort_double(double *data, size_t count);
+
+/* LSD radix sort (4 passes of 8 bits). scratch must hold count ints. */
+void sort_int_radix(int *data, int *scratch, size_t count);
+
+/* Radix sort for count >= SORT_RADIX_THRESHOLD when scratch is given,
+ * introsort otherwise. */
+void sort_int_with_scratch(int *data, int *scratch, size_t count);
+
+#endif /* SORT_ENGINE_H */
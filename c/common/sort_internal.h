@@ -0,0 +1,112 @@
+/*
+ * SORT INTERNAL - Primitives shared by sort_engine.c and selection.c
+ *
+ * Not part of the public API. DEFINE_SORT_PRIMITIVES(SUFFIX, TYPE)
+ * instantiates insertion sort, heapsort and a median-of-three Hoare
+ * partition for one element type.
+ */
+
+#ifndef SORT_INTERNAL_H
+#define SORT_INTERNAL_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sort_engine.h"
+
+typedef struct {
+    size_t lo;
+    size_t hi;       /* Inclusive */
+    unsigned depth;  /* Partitions left before heapsort fallback */
+} SortRange;
+
+static inline unsigned depth_limit(size_t count) {
+    unsigned log2n = 0;
+    for (size_t n = count; n > 1 && log2n < SORT_STACK_DEPTH; n >>= 1) {
+        log2n++;
+    }
+    return 2 * log2n;
+}
+
+#define DEFINE_SORT_PRIMITIVES(SUFFIX, TYPE)                                   \
+                                                                               \
+static inline void insertion_sort_##SUFFIX(TYPE *a, size_t lo, size_t hi) {    \
+    for (size_t i = lo + 1; i <= hi; i++) {                                    \
+        TYPE key = a[i];                                                       \
+        size_t j = i;                                                          \
+        while (j > lo && a[j - 1] > key) {                                     \
+            a[j] = a[j - 1];                                                   \
+            j--;                                                               \
+        }                                                                      \
+        a[j] = key;                                                            \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+static inline void sift_down_##SUFFIX(TYPE *a, size_t root, size_t count) {    \
+    TYPE value = a[root];                                                      \
+    for (size_t level = 0; level < SORT_STACK_DEPTH; level++) {                \
+        size_t child = 2 * root + 1;                                           \
+        if (child >= count) {                                                  \
+            break;                                                             \
+        }                                                                      \
+        if (child + 1 < count && a[child + 1] > a[child]) {                    \
+            child++;                                                           \
+        }                                                                      \
+        if (!(a[child] > value)) {                                             \
+            break;                                                             \
+        }                                                                      \
+        a[root] = a[child];                                                    \
+        root = child;                                                          \
+    }                                                                          \
+    a[root] = value;                                                           \
+}                                                                              \
+                                                                               \
+static inline void heap_sort_##SUFFIX(TYPE *a, size_t count) {                 \
+    for (size_t i = count / 2; i > 0; i--) {                                   \
+        sift_down_##SUFFIX(a, i - 1, count);                                   \
+    }                                                                          \
+    for (size_t end = count - 1; end > 0; end--) {                             \
+        TYPE top = a[0];                                                       \
+        a[0] = a[end];                                                         \
+        a[end] = top;                                                          \
+        sift_down_##SUFFIX(a, 0, end);                                         \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+static inline void order3_##SUFFIX(TYPE *a, size_t x, size_t y, size_t z) {    \
+    TYPE t;                                                                    \
+    if (a[y] < a[x]) { t = a[x]; a[x] = a[y]; a[y] = t; }                      \
+    if (a[z] < a[y]) { t = a[y]; a[y] = a[z]; a[z] = t; }                      \
+    if (a[y] < a[x]) { t = a[x]; a[x] = a[y]; a[y] = t; }                      \
+}                                                                              \
+                                                                               \
+/* Hoare partition around the median of three; returns p with          */      \
+/* [lo, p] <= pivot <= [p + 1, hi] and lo <= p < hi.                   */      \
+static inline size_t partition_##SUFFIX(TYPE *a, size_t lo, size_t hi) {       \
+    size_t mid = lo + (hi - lo) / 2;                                           \
+    order3_##SUFFIX(a, lo, mid, hi);                                           \
+    const TYPE pivot = a[mid];                                                 \
+    size_t i = lo;                                                             \
+    size_t j = hi;                                                             \
+    for (size_t pass = 0; pass <= hi - lo; pass++) {                           \
+        while (a[i] < pivot) {                                                 \
+            i++;                                                               \
+        }                                                                      \
+        while (a[j] > pivot) {                                                 \
+            j--;                                                               \
+        }                                                                      \
+        if (i >= j) {                                                          \
+            break;                                                             \
+        }                                                                      \
+        TYPE t = a[i];                                                         \
+        a[i] = a[j];                                                           \
+        a[j] = t;                                                              \
+        i++;                                                                   \
+        j--;                                                                   \
+    }                                                                          \
+    assert(j < hi);                                                            \
+    return j;                                                                  \
+}
+
+#endif /* SORT_INTERNAL_H */
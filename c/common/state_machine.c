@@ -0,0 +1,169 @@
+/*
+ * STATE MACHINE - Implementation
+ *
+ * Cell index = (state << row_shift) | input, with the row length the
+ * smallest power of two above input_count so small machines stay small.
+ * Column input_count holds the invalid-input cells and row state_count
+ * the fault cells; clamping both indexes with an unsigned min() sends
+ * every out-of-range byte there without a branch, in both paths.
+ */
+
+#include "state_machine.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "cpu_features.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STATE_MACHINE_HAVE_SIMD_PATH 1
+#include <immintrin.h>
+#else
+#define STATE_MACHINE_HAVE_SIMD_PATH 0
+#endif
+
+_Static_assert(STATE_MACHINE_ROW_CELLS > STATE_MACHINE_MAX_INPUTS, "row needs the invalid column");
+_Static_assert(STATE_MACHINE_MAX_STATES < STATE_MACHINE_ACTION_INVALID, "states fit uint8_t");
+
+static inline uint16_t make_cell(uint8_t next, uint8_t action) {
+    return (uint16_t)(next | (action << 8));
+}
+
+static inline uint32_t clamp(uint32_t value, uint32_t limit) {
+    return (value < limit) ? value : limit;
+}
+
+// ============================================
+// SCALAR KERNEL
+// ============================================
+
+static inline uint16_t lookup(const StateMachine *sm, uint8_t state, uint8_t input) {
+    uint32_t row = clamp(state, sm->state_count);
+    uint32_t column = clamp(input, sm->input_count);
+    return sm->cells[(row << sm->row_shift) | column];
+}
+
+static void step_batch_scalar(const StateMachine *sm, uint8_t *states, const uint8_t *inputs,
+                              uint8_t *actions, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint16_t cell = lookup(sm, states[i], inputs[i]);
+        states[i] = (uint8_t)cell;
+        if (actions != NULL) {
+            actions[i] = (uint8_t)(cell >> 8);
+        }
+    }
+}
+
+// ============================================
+// AVX2 KERNEL
+// ============================================
+
+#if STATE_MACHINE_HAVE_SIMD_PATH
+
+__attribute__((target("avx2")))
+static void step_batch_avx2(const StateMachine *sm, uint8_t *states, const uint8_t *inputs,
+                            uint8_t *actions, size_t count) {
+    const __m256i state_limit = _mm256_set1_epi32((int)sm->state_count);
+    const __m256i input_limit = _mm256_set1_epi32((int)sm->input_count);
+    const __m128i shift = _mm_cvtsi32_si128((int)sm->row_shift);
+    // Per 128-bit lane: next states (byte 0 of each cell) then actions (byte 1)
+    const __m256i split = _mm256_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, -1, -1, -1, -1, -1, -1, -1, -1,
+                                           0, 4, 8, 12, 1, 5, 9, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i gather_order = _mm256_setr_epi32(0, 4, 1, 5, 2, 3, 6, 7);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i state = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(const void *)(states + i)));
+        __m256i input = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(const void *)(inputs + i)));
+        __m256i index = _mm256_or_si256(_mm256_sll_epi32(_mm256_min_epu32(state, state_limit), shift),
+                                        _mm256_min_epu32(input, input_limit));
+        // 32-bit loads at 2-byte steps: the cell is the low half (padding cell covers the last one)
+        __m256i cells = _mm256_i32gather_epi32((const int *)(const void *)sm->cells, index, 2);
+
+        __m256i bytes = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(cells, split), gather_order);
+        __m128i packed = _mm256_castsi256_si128(bytes);  // 8 next states, then 8 actions
+        _mm_storel_epi64((__m128i *)(void *)(states + i), packed);
+        if (actions != NULL) {
+            _mm_storel_epi64((__m128i *)(void *)(actions + i), _mm_srli_si128(packed, 8));
+        }
+    }
+    step_batch_scalar(sm, states + i, inputs + i, (actions != NULL) ? actions + i : NULL, count - i);
+}
+
+#endif /* STATE_MACHINE_HAVE_SIMD_PATH */
+
+// ============================================
+// PUBLIC API
+// ============================================
+
+bool state_machine_compile(StateMachine *sm, size_t state_count, size_t input_count,
+                           uint8_t fault_state, const StateTransition *transitions,
+                           size_t count) {
+    assert(sm != NULL && (transitions != NULL || count == 0));  // Rule 7
+
+    if (state_count == 0 || state_count > STATE_MACHINE_MAX_STATES || input_count == 0 ||
+        input_count > STATE_MACHINE_MAX_INPUTS || fault_state >= state_count) {
+        return false;
+    }
+    memset(sm, 0, sizeof(*sm));
+    sm->state_count = (uint32_t)state_count;
+    sm->input_count = (uint32_t)input_count;
+    while ((1u << sm->row_shift) <= input_count) {
+        sm->row_shift++;
+    }
+
+    // Defaults: unlisted pairs stay put, invalid inputs are flagged, the
+    // fault row catches corrupted states
+    uint32_t row_cells = 1u << sm->row_shift;
+    for (uint32_t row = 0; row <= state_count; row++) {
+        for (uint32_t column = 0; column < row_cells; column++) {
+            uint8_t next = (row < state_count) ? (uint8_t)row : fault_state;
+            uint8_t action = (row < state_count && column < input_count)
+                                 ? STATE_MACHINE_ACTION_NONE
+                                 : STATE_MACHINE_ACTION_INVALID;
+            sm->cells[(row << sm->row_shift) | column] = make_cell(next, action);
+        }
+    }
+
+    bool listed[STATE_MACHINE_MAX_STATES * STATE_MACHINE_ROW_CELLS] = {false};
+    for (size_t t = 0; t < count; t++) {
+        const StateTransition *tr = &transitions[t];
+        if (tr->from >= state_count || tr->to >= state_count || tr->input >= input_count ||
+            tr->action == STATE_MACHINE_ACTION_INVALID) {
+            return false;
+        }
+        uint32_t index = ((uint32_t)tr->from << sm->row_shift) | tr->input;
+        uint16_t cell = make_cell(tr->to, tr->action);
+        if (listed[index] && sm->cells[index] != cell) {
+            return false;  // Contradictory duplicate
+        }
+        listed[index] = true;
+        sm->cells[index] = cell;
+    }
+    return true;
+}
+
+uint8_t state_machine_step(const StateMachine *sm, uint8_t state, uint8_t input,
+                           uint8_t *action) {
+    assert(sm != NULL);  // Rule 7
+
+    uint16_t cell = lookup(sm, state, input);
+    if (action != NULL) {
+        *action = (uint8_t)(cell >> 8);
+    }
+    return (uint8_t)cell;
+}
+
+void state_machine_step_batch(const StateMachine *sm, uint8_t *states, const uint8_t *inputs,
+                              uint8_t *actions, size_t count) {
+    assert(sm != NULL);  // Rule 7
+    assert((states != NULL && inputs != NULL) || count == 0);
+
+#if STATE_MACHINE_HAVE_SIMD_PATH
+    if (cpu_has_avx2()) {
+        step_batch_avx2(sm, states, inputs, actions, count);
+        return;
+    }
+#endif
+    step_batch_scalar(sm, states, inputs, actions, count);
+}
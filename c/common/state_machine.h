@@ -0,0 +1,66 @@
+/*
+ * STATE MACHINE - Table-driven engine for many independent instances
+ *
+ * A machine is compiled once from a list of transitions (state x input
+ * -> next state + action id) into a dense table of 16-bit cells
+ * (next | action << 8); its instances are just one uint8_t state each,
+ * stored as a packed column by the caller. state_machine_step_batch()
+ * advances a whole column: per instance one index computation and one
+ * table load, 8 instances per AVX2 gather when the CPU has it.
+ *
+ * Every (state, input) pair not listed keeps the state with action
+ * STATE_MACHINE_ACTION_NONE. Out-of-range bytes are never used as
+ * indexes: an input >= input_count keeps the state with action
+ * STATE_MACHINE_ACTION_INVALID, and a state >= state_count (a corrupted
+ * column) moves to the machine's fault state with the same action.
+ *
+ * The table lives inside StateMachine (about 8 KB, no allocation).
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c state_machine.c
+ */
+
+#ifndef STATE_MACHINE_H
+#define STATE_MACHINE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define STATE_MACHINE_MAX_STATES 64
+#define STATE_MACHINE_MAX_INPUTS 63
+#define STATE_MACHINE_ROW_CELLS 64   /* Power of two > STATE_MACHINE_MAX_INPUTS */
+#define STATE_MACHINE_ACTION_NONE 0
+#define STATE_MACHINE_ACTION_INVALID 0xFF
+
+typedef struct {
+    uint8_t from;
+    uint8_t input;
+    uint8_t to;
+    uint8_t action;  /* Caller-defined id, not STATE_MACHINE_ACTION_INVALID */
+} StateTransition;
+
+typedef struct {
+    /* Row per state plus the fault row, one padding cell for 32-bit gathers */
+    uint16_t cells[(STATE_MACHINE_MAX_STATES + 1) * STATE_MACHINE_ROW_CELLS + 1];
+    uint32_t state_count;
+    uint32_t input_count;
+    uint32_t row_shift;  /* log2 of the row length */
+} StateMachine;
+
+/* Builds sm from count transitions. False if a count is out of range,
+ * fault_state >= state_count, a transition is out of range or uses the
+ * reserved action, or a pair is listed twice with different results. */
+bool state_machine_compile(StateMachine *sm, size_t state_count, size_t input_count,
+                           uint8_t fault_state, const StateTransition *transitions,
+                           size_t count);
+
+/* One instance: returns the next state, stores the action if action != NULL */
+uint8_t state_machine_step(const StateMachine *sm, uint8_t state, uint8_t input,
+                           uint8_t *action);
+
+/* Advances states[i] by inputs[i] in place for count instances; writes
+ * the action ids to actions (may be NULL) */
+void state_machine_step_batch(const StateMachine *sm, uint8_t *states, const uint8_t *inputs,
+                              uint8_t *actions, size_t count);
+
+#endif /* STATE_MACHINE_H */
@@ -54,6 +54,9 @@
 #include <stdbool.h>
 #include <assert.h>
 
+#include "bounded_string.h"
+#include "clock_source.h"
+
 // ═══════════════════════════════════════════════════════════════════════
 // PATTERN 0: ALLOCATION STATIQUE (LE PLUS SÛR)
 // Pas de malloc nécessaire dans la plupart des cas!
@@ -143,7 +146,7 @@ void static_allocation_example(void) {
 
 typedef struct {
     char text[MESSAGE_SIZE];
-    uint32_t timestamp;
+    uint64_t timestamp;  // ns monotones (clock_source)
     uint8_t priority;
 } Message;
 
@@ -152,12 +155,14 @@ typedef struct {
     size_t head;
     size_t tail;
     size_t count;
+    ClockSource clock;               // Source d'horodatage propre à la file
 } MessageQueue;
 
 // Initialisation O(1) - pas de malloc
 void msg_queue_init(MessageQueue *queue) {
     assert(queue != NULL);
     memset(queue, 0, sizeof(MessageQueue));
+    (void)clock_source_init(&queue->clock, CLOCK_SOURCE_TSC);  // Repli: MONOTONIC
 }
 
 // Enqueue - vérifie les bornes
@@ -171,9 +176,8 @@ bool msg_queue_push(MessageQueue *queue, const char *text, uint8_t priority) {
     }
     
     Message *msg = &queue->messages[queue->tail];
-    strncpy(msg->text, text, MESSAGE_SIZE - 1);
-    msg->text[MESSAGE_SIZE - 1] = '\0';
-    msg->timestamp = (uint32_t)queue->count; // Simulé
+    (void)bstr_copy(msg->text, MESSAGE_SIZE, text);  // Tronque, toujours terminé, sans zero-fill
+    msg->timestamp = clock_source_now(&queue->clock);
     msg->priority = priority;
     
     queue->tail = (queue->tail + 1) % MAX_MESSAGES;
@@ -274,11 +278,8 @@ bool hash_table_insert(HashTable *table, const char *key, const char *value) {
         uint32_t current = (index + probe) % HASH_TABLE_SIZE;
         
         if (!table->entries[current].occupied) {
-            strncpy(table->entries[current].key, key, KEY_SIZE - 1);
-            table->entries[current].key[KEY_SIZE - 1] = '\0';
-            
-            strncpy(table->entries[current].value, value, VALUE_SIZE - 1);
-            table->entries[current].value[VALUE_SIZE - 1] = '\0';
+            (void)bstr_copy(table->entries[current].key, KEY_SIZE, key);
+            (void)bstr_copy(table->entries[current].value, VALUE_SIZE, value);
             
             table->entries[current].occupied = true;
             table->count++;
@@ -287,8 +288,7 @@ bool hash_table_insert(HashTable *table, const char *key, const char *value) {
         
         // Key already exists - update
         if (strcmp(table->entries[current].key, key) == 0) {
-            strncpy(table->entries[current].value, value, VALUE_SIZE - 1);
-            table->entries[current].value[VALUE_SIZE - 1] = '\0';
+            (void)bstr_copy(table->entries[current].value, VALUE_SIZE, value);
             return true;
         }
         
@@ -315,8 +315,7 @@ bool hash_table_get(const HashTable *table, const char *key, char *out_value, si
         }
         
         if (strcmp(table->entries[current].key, key) == 0) {
-            strncpy(out_value, table->entries[current].value, out_size - 1);
-            out_value[out_size - 1] = '\0';
+            (void)bstr_copy(out_value, out_size, table->entries[current].value);
             return true;
         }
         
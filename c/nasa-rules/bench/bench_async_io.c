@@ -0,0 +1,167 @@
+/*
+ * BENCHMARK - Asynchronous file I/O backends
+ *
+ * Writes the same CSV lines three ways and reads the file back:
+ *   write()   telemetry_csv, one blocking write() per 64 KiB
+ *   uring     AsyncIoStream on io_uring (registered buffers)
+ *   threads   AsyncIoStream on the pread/pwrite thread pool
+ * Reads compare one pread() per 64 KiB with batches of
+ * ASYNC_IO_POOL_BUFFERS reads per submit. The page cache absorbs most
+ * of the device time, so this measures submission overhead and overlap
+ * with formatting rather than disk bandwidth.
+ *
+ * Usage: make bench   (or ./bench_async_io [samples] [path])
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "async_io.h"
+#include "telemetry_csv.h"
+
+#define DEFAULT_BENCH_SAMPLES 4000000
+#define DEFAULT_BENCH_PATH "/tmp/bench_async_io.csv"
+
+static TelemetryCsvWriter csv_writer;
+static AsyncIo io;
+static AsyncIoStream stream;
+static uint8_t read_buffer[ASYNC_IO_BUFFER_SIZE];
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static size_t format_sample(char *line, long i) {
+    return telemetry_csv_format_line(line, (int)(i % 16), 20.0 + (double)(i % 1000) / 100.0,
+                                     (uint32_t)(1700000000 + i / 1000));
+}
+
+static void report(const char *name, uint64_t bytes, uint64_t ns) {
+    printf("  %-8s %8.1f MB/s  (%.1f ms)\n", name,
+           (double)bytes / ((double)ns / 1e9) / 1e6, (double)ns / 1e6);
+}
+
+static uint64_t bench_write_syscall(long samples, const char *path) {
+    if (!telemetry_csv_open(&csv_writer, path)) {
+        printf("  write(): cannot open %s\n", path);
+        return 0;
+    }
+    uint64_t start = now_ns();
+    for (long i = 0; i < samples; i++) {
+        (void)telemetry_csv_write(&csv_writer, (int)(i % 16),
+                                  20.0 + (double)(i % 1000) / 100.0,
+                                  (uint32_t)(1700000000 + i / 1000));
+    }
+    bool ok = telemetry_csv_close(&csv_writer);
+    uint64_t ns = now_ns() - start;
+
+    struct stat st;
+    uint64_t bytes = (stat(path, &st) == 0) ? (uint64_t)st.st_size : 0;
+    report(ok ? "write()" : "failed", bytes, ns);
+    return bytes;
+}
+
+static void bench_write_stream(long samples, const char *path, const char *name) {
+    if (!async_io_stream_open(&stream, &io, path)) {
+        printf("  %s: cannot open %s\n", name, path);
+        return;
+    }
+    uint64_t bytes = 0;
+    uint64_t start = now_ns();
+    char line[TELEMETRY_CSV_MAX_LINE];
+    for (long i = 0; i < samples; i++) {
+        size_t len = format_sample(line, i);
+        bytes += len;
+        (void)async_io_stream_write(&stream, line, len);
+    }
+    bool ok = async_io_stream_close(&stream);
+    uint64_t ns = now_ns() - start;
+    report(ok ? name : "failed", bytes, ns);
+}
+
+static void bench_read_pread(const char *path, uint64_t size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    uint64_t start = now_ns();
+    uint64_t total = 0;
+    for (uint64_t offset = 0; offset < size; offset += ASYNC_IO_BUFFER_SIZE) {
+        ssize_t n = pread(fd, read_buffer, ASYNC_IO_BUFFER_SIZE, (off_t)offset);
+        total += (n > 0) ? (uint64_t)n : 0;
+    }
+    report("pread()", total, now_ns() - start);
+    close(fd);
+}
+
+static void bench_read_batched(const char *path, uint64_t size, const char *name) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    uint64_t start = now_ns();
+    uint64_t total = 0;
+    AsyncIoCompletion completions[ASYNC_IO_POOL_BUFFERS];
+    for (uint64_t offset = 0; offset < size;) {
+        size_t batch = 0;
+        while (batch < ASYNC_IO_POOL_BUFFERS && offset < size) {
+            (void)async_io_prep_read(&io, fd, async_io_buffer(&io, batch),
+                                     ASYNC_IO_BUFFER_SIZE, offset, batch);
+            offset += ASYNC_IO_BUFFER_SIZE;
+            batch++;
+        }
+        (void)async_io_submit(&io);
+        size_t done = 0;
+        while (done < batch) {
+            size_t n = async_io_reap(&io, completions, ASYNC_IO_POOL_BUFFERS, batch - done);
+            for (size_t i = 0; i < n; i++) {
+                total += (completions[i].result > 0) ? (uint64_t)completions[i].result : 0;
+            }
+            done += n;
+        }
+    }
+    report(name, total, now_ns() - start);
+    close(fd);
+}
+
+static void bench_backend(AsyncIoBackend backend, long samples, const char *path,
+                          uint64_t size) {
+    if (!async_io_init(&io, backend)) {
+        printf("  backend unavailable\n");
+        return;
+    }
+    const char *name = (async_io_backend(&io) == ASYNC_IO_BACKEND_URING) ? "uring" : "threads";
+    if (backend == ASYNC_IO_BACKEND_URING && async_io_backend(&io) != backend) {
+        printf("  io_uring unavailable, measuring the thread pool\n");
+    }
+    bench_write_stream(samples, path, name);
+    bench_read_batched(path, size, name);
+    async_io_destroy(&io);
+}
+
+int main(int argc, char **argv) {
+    long samples = DEFAULT_BENCH_SAMPLES;
+    const char *path = DEFAULT_BENCH_PATH;
+    if (argc > 1) {
+        samples = strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        path = argv[2];
+    }
+
+    printf("Async I/O: %ld CSV lines to %s (write, then read back)\n", samples, path);
+    uint64_t size = bench_write_syscall(samples, path);
+    bench_read_pread(path, size);
+    bench_backend(ASYNC_IO_BACKEND_URING, samples, path, size);
+    bench_backend(ASYNC_IO_BACKEND_THREADS, samples, path, size);
+    (void)unlink(path);
+    return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * BENCHMARK - Asynchronous telemetry writer
+ *
+ * Simulates an acquisition loop producing samples and measures how long
+ * each append keeps the loop busy:
+ *   sync   telemetry_csv in the loop, write() every 4096 samples
+ *   async  telemetry_async_append, a writer thread does the write()
+ * Reports mean, p99.9 and worst append latency plus dropped batches.
+ *
+ * Usage: make bench   (or ./bench_async_writer [samples] [path])
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "telemetry_async_writer.h"
+#include "telemetry_csv.h"
+
+#define DEFAULT_BENCH_SAMPLES 2000000
+#define DEFAULT_BENCH_PATH "/tmp/bench_async_writer.csv"
+#define LATENCY_BUCKETS 64  /* Power-of-two ns buckets */
+
+static TelemetryCsvWriter sync_writer;
+static TelemetryAsyncWriter async_writer;
+static uint64_t histogram[LATENCY_BUCKETS];
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void record(uint64_t ns) {
+    int bucket = 0;
+    while (bucket < LATENCY_BUCKETS - 1 && (1ull << (bucket + 1)) <= ns) {
+        bucket++;
+    }
+    histogram[bucket]++;
+}
+
+/* Upper bound of the bucket holding the q-quantile */
+static uint64_t quantile(long samples, double q) {
+    uint64_t target = (uint64_t)(q * (double)samples);
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < LATENCY_BUCKETS; bucket++) {
+        seen += histogram[bucket];
+        if (seen > target) {
+            return 1ull << (bucket + 1);
+        }
+    }
+    return UINT64_MAX;
+}
+
+static TelemetryData make_sample(long i) {
+    TelemetryData sample = {
+        .sensor_id = (int)(i % 16),
+        .temperature = 20.0 + (double)(i % 1000) / 100.0,
+        .timestamp = (uint32_t)(1700000000 + i / 1000),
+        .valid = true,
+        .time_ns = (uint64_t)i
+    };
+    return sample;
+}
+
+static void report(const char *name, long samples, uint64_t total_ns, uint64_t worst_ns) {
+    printf("  %-5s %6.1f ns/sample mean  p99.9 < %6llu ns  worst %8.1f us\n",
+           name, (double)total_ns / (double)samples,
+           (unsigned long long)quantile(samples, 0.999), (double)worst_ns / 1000.0);
+}
+
+static void bench_sync(long samples, const char *path) {
+    memset(histogram, 0, sizeof(histogram));
+    if (!telemetry_csv_open(&sync_writer, path)) {
+        printf("  sync: cannot open %s\n", path);
+        return;
+    }
+
+    uint64_t worst = 0;
+    uint64_t start = now_ns();
+    for (long i = 0; i < samples; i++) {
+        TelemetryData sample = make_sample(i);
+        uint64_t t0 = now_ns();
+        (void)telemetry_csv_write(&sync_writer, sample.sensor_id, sample.temperature,
+                                  sample.timestamp);
+        if ((i + 1) % TELEMETRY_ASYNC_BATCH == 0) {
+            (void)telemetry_csv_flush(&sync_writer);
+        }
+        uint64_t dt = now_ns() - t0;
+        worst = (dt > worst) ? dt : worst;
+        record(dt);
+    }
+    uint64_t total = now_ns() - start;
+    (void)telemetry_csv_close(&sync_writer);
+    report("sync", samples, total, worst);
+}
+
+static void bench_async(long samples, const char *path) {
+    memset(histogram, 0, sizeof(histogram));
+    if (!telemetry_async_open(&async_writer, path)) {
+        printf("  async: cannot open %s\n", path);
+        return;
+    }
+
+    uint64_t worst = 0;
+    uint64_t start = now_ns();
+    for (long i = 0; i < samples; i++) {
+        TelemetryData sample = make_sample(i);
+        uint64_t t0 = now_ns();
+        (void)telemetry_async_append(&async_writer, &sample);
+        uint64_t dt = now_ns() - t0;
+        worst = (dt > worst) ? dt : worst;
+        record(dt);
+    }
+    uint64_t total = now_ns() - start;
+    (void)telemetry_async_close(&async_writer);
+    report("async", samples, total, worst);
+
+    TelemetryAsyncStats stats;
+    telemetry_async_get_stats(&async_writer, &stats);
+    printf("        written %llu samples in %llu batches, dropped %llu batches (%llu samples)\n",
+           (unsigned long long)stats.samples_written, (unsigned long long)stats.batches_written,
+           (unsigned long long)stats.batches_dropped, (unsigned long long)stats.samples_dropped);
+}
+
+int main(int argc, char **argv) {
+    long samples = DEFAULT_BENCH_SAMPLES;
+    const char *path = DEFAULT_BENCH_PATH;
+    if (argc > 1) {
+        samples = strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        path = argv[2];
+    }
+
+    printf("Telemetry writer: %ld samples to %s (acquisition-side cost per append)\n",
+           samples, path);
+    bench_sync(samples, path);
+    bench_async(samples, path);
+    (void)unlink(path);
+    return 0;
+}
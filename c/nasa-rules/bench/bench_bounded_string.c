@@ -0,0 +1,88 @@
+/*
+ * BENCHMARK - bstr_copy vs strncpy
+ *
+ * Copies short messages (8-120 chars) into 128-byte fields, the shape of
+ * the message queue and hash table call sites, with the strncpy idiom
+ * (copy, zero-fill, terminate) and with bstr_copy (no zero-fill).
+ *
+ * Usage: make bench   (or ./bench_bounded_string [rounds])
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bounded_string.h"
+
+#define FIELD_SIZE 128
+#define POOL_STRINGS 4096
+#define DEFAULT_ROUNDS 500
+
+/* Rule 3: everything is static */
+static char g_pool[POOL_STRINGS][FIELD_SIZE];
+static char g_dest[POOL_STRINGS][FIELD_SIZE];
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void fill_pool(void) {
+    srand(42);
+    for (size_t i = 0; i < POOL_STRINGS; i++) {
+        size_t len = 8 + (size_t)rand() % 113;
+        for (size_t j = 0; j < len; j++) {
+            g_pool[i][j] = (char)('a' + rand() % 26);
+        }
+        g_pool[i][len] = '\0';
+    }
+}
+
+static void report(const char *name, double libc_time, double bstr_time, long ops, size_t sink) {
+    printf("  %-8s libc %6.2f ns  bounded_string %6.2f ns  (%.1fx)  [%zu]\n", name,
+           libc_time / ops * 1e9, bstr_time / ops * 1e9, libc_time / bstr_time, sink & 0xFF);
+}
+
+int main(int argc, char **argv) {
+    long rounds = DEFAULT_ROUNDS;
+    if (argc > 1) {
+        rounds = strtol(argv[1], NULL, 10);
+    }
+    if (rounds <= 0) {
+        fprintf(stderr, "rounds must be positive\n");
+        return 1;
+    }
+    fill_pool();
+    const long ops = rounds * POOL_STRINGS;
+    size_t sink = 0;
+    double start, libc_time, bstr_time;
+
+    printf("Bounded string benchmark (%ld ops, %d-byte fields, ns/op)\n", ops, FIELD_SIZE);
+
+    start = now_seconds();
+    for (long r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < POOL_STRINGS; i++) {
+            // The libc idiom being replaced: copy, zero-fill, terminate
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wstringop-truncation"
+            strncpy(g_dest[i], g_pool[i], FIELD_SIZE - 1);
+#pragma GCC diagnostic pop
+            g_dest[i][FIELD_SIZE - 1] = '\0';
+        }
+    }
+    libc_time = now_seconds() - start;
+    start = now_seconds();
+    for (long r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < POOL_STRINGS; i++) {
+            sink += bstr_copy(g_dest[i], FIELD_SIZE, g_pool[i]);
+        }
+    }
+    bstr_time = now_seconds() - start;
+    report("copy", libc_time, bstr_time, ops, sink);
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * BENCHMARK - Clock sources
+ *
+ * Measures the cost of one timestamp (ns/call) for each ClockSource
+ * kind, plus time(NULL) as the former per-sample baseline, and reports
+ * the smallest step each source can observe.
+ *
+ * Usage: make bench   (or ./bench_clock_source [calls])
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "clock_source.h"
+
+#define DEFAULT_BENCH_CALLS 20000000
+#define RESOLUTION_PROBES 1000
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Smallest non-zero difference between consecutive readings */
+static uint64_t observed_resolution(ClockSource *clock) {
+    uint64_t best = UINT64_MAX;
+    uint64_t previous = clock_source_now(clock);
+    for (long i = 0; i < RESOLUTION_PROBES * 10000L; i++) {
+        uint64_t t = clock_source_now(clock);
+        if (t != previous) {
+            uint64_t step = t - previous;
+            best = (step < best) ? step : best;
+            previous = t;
+        }
+        if (i >= RESOLUTION_PROBES && best != UINT64_MAX) {
+            break;
+        }
+    }
+    return best;
+}
+
+static void bench_source(ClockSourceKind kind, long calls) {
+    ClockSource clock;
+    bool exact = clock_source_init(&clock, kind);
+
+    uint64_t sink = 0;
+    double start = now_seconds();
+    for (long i = 0; i < calls; i++) {
+        sink += clock_source_now(&clock);
+    }
+    double elapsed = now_seconds() - start;
+
+    uint64_t resolution = (kind == CLOCK_SOURCE_CACHED) ? 0 : observed_resolution(&clock);
+    printf("  %-10s %6.2f ns/call  resolution %8llu ns%s  (sink %llu)\n",
+           clock_source_name(kind), elapsed / calls * 1e9,
+           (unsigned long long)resolution,
+           exact ? "" : "  [fell back to monotonic]",
+           (unsigned long long)(sink & 0xFF));
+}
+
+static void bench_time(long calls) {
+    time_t sink = 0;
+    double start = now_seconds();
+    for (long i = 0; i < calls; i++) {
+        sink += time(NULL);
+    }
+    double elapsed = now_seconds() - start;
+    printf("  %-10s %6.2f ns/call  resolution 1000000000 ns  (sink %ld)\n",
+           "time(NULL)", elapsed / calls * 1e9, (long)(sink & 0xFF));
+}
+
+int main(int argc, char **argv) {
+    long calls = DEFAULT_BENCH_CALLS;
+    if (argc > 1) {
+        calls = strtol(argv[1], NULL, 10);
+    }
+    if (calls <= 0) {
+        fprintf(stderr, "calls must be positive\n");
+        return 1;
+    }
+
+    printf("Clock source benchmark (%ld calls each, invariant TSC: %s)\n",
+           calls, clock_source_tsc_available() ? "yes" : "no");
+    bench_time(calls);
+    bench_source(CLOCK_SOURCE_MONOTONIC, calls);
+    bench_source(CLOCK_SOURCE_TSC, calls);
+    bench_source(CLOCK_SOURCE_COARSE, calls);
+    bench_source(CLOCK_SOURCE_CACHED, calls);
+    return 0;
+}
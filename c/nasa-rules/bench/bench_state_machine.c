@@ -0,0 +1,148 @@
+/*
+ * BENCHMARK - Device fleet: switch per instance vs table-driven batch
+ *
+ * Advances 50,000 device state machines (4 states, 6 inputs, random
+ * inputs per round) with a hand-written nested switch per instance, with
+ * state_machine_step() per instance, and with one
+ * state_machine_step_batch() call per round over the packed state column.
+ *
+ * Usage: make bench   (or ./bench_state_machine [rounds])
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "state_machine.h"
+
+#define FLEET_SIZE 50000
+#define INPUT_ROUNDS 16       /* Distinct input columns, cycled */
+#define DEFAULT_ROUNDS 400
+
+enum { IDLE, RUNNING, PAUSED, FAULTED, STATE_COUNT };
+enum { START, PAUSE, RESUME, STOP, FAULT, RESET, INPUT_COUNT };
+enum { NONE, POWER_ON, POWER_OFF, ALARM };
+
+static const StateTransition TRANSITIONS[] = {
+    {IDLE, START, RUNNING, POWER_ON},   {RUNNING, PAUSE, PAUSED, NONE},
+    {RUNNING, STOP, IDLE, POWER_OFF},   {PAUSED, RESUME, RUNNING, NONE},
+    {PAUSED, STOP, IDLE, POWER_OFF},    {IDLE, FAULT, FAULTED, ALARM},
+    {RUNNING, FAULT, FAULTED, ALARM},   {PAUSED, FAULT, FAULTED, ALARM},
+    {FAULTED, RESET, IDLE, NONE},
+};
+
+/* Rule 3: everything is static */
+static StateMachine g_machine;
+static uint8_t g_inputs[INPUT_ROUNDS][FLEET_SIZE];
+static uint8_t g_states[FLEET_SIZE];
+static uint8_t g_actions[FLEET_SIZE];
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* The same machine written as code */
+static uint8_t switch_step(uint8_t state, uint8_t input, uint8_t *action) {
+    *action = NONE;
+    switch (state) {
+        case IDLE:
+            switch (input) {
+                case START: *action = POWER_ON; return RUNNING;
+                case FAULT: *action = ALARM; return FAULTED;
+                default: return IDLE;
+            }
+        case RUNNING:
+            switch (input) {
+                case PAUSE: return PAUSED;
+                case STOP: *action = POWER_OFF; return IDLE;
+                case FAULT: *action = ALARM; return FAULTED;
+                default: return RUNNING;
+            }
+        case PAUSED:
+            switch (input) {
+                case RESUME: return RUNNING;
+                case STOP: *action = POWER_OFF; return IDLE;
+                case FAULT: *action = ALARM; return FAULTED;
+                default: return PAUSED;
+            }
+        case FAULTED:
+            return (input == RESET) ? IDLE : FAULTED;
+        default:
+            *action = 0xFF;
+            return FAULTED;
+    }
+}
+
+/* Sum of the final states and actions, to compare the variants */
+static unsigned fingerprint(void) {
+    unsigned sum = 0;
+    for (size_t i = 0; i < FLEET_SIZE; i++) {
+        sum = sum * 31u + g_states[i] * 7u + g_actions[i];
+    }
+    return sum;
+}
+
+static void report(const char *name, double elapsed, long rounds, double baseline) {
+    double ns = elapsed / ((double)rounds * FLEET_SIZE) * 1e9;
+    printf("  %-26s %6.2f ns/instance  %7.1f M steps/s  (%.1fx)  [%08X]\n", name, ns,
+           1e3 / ns, baseline / elapsed, fingerprint());
+}
+
+int main(int argc, char **argv) {
+    long rounds = DEFAULT_ROUNDS;
+    if (argc > 1) {
+        rounds = strtol(argv[1], NULL, 10);
+    }
+    if (rounds <= 0) {
+        fprintf(stderr, "rounds must be positive\n");
+        return 1;
+    }
+    if (!state_machine_compile(&g_machine, STATE_COUNT, INPUT_COUNT, FAULTED, TRANSITIONS,
+                               sizeof(TRANSITIONS) / sizeof(TRANSITIONS[0]))) {
+        fprintf(stderr, "invalid transition table\n");
+        return 1;
+    }
+    srand(42);
+    for (size_t r = 0; r < INPUT_ROUNDS; r++) {
+        for (size_t i = 0; i < FLEET_SIZE; i++) {
+            g_inputs[r][i] = (uint8_t)(rand() % INPUT_COUNT);
+        }
+    }
+
+    printf("State machine benchmark (%d instances, %ld rounds)\n", FLEET_SIZE, rounds);
+
+    memset(g_states, IDLE, sizeof(g_states));
+    double start = now_seconds();
+    for (long r = 0; r < rounds; r++) {
+        const uint8_t *inputs = g_inputs[r % INPUT_ROUNDS];
+        for (size_t i = 0; i < FLEET_SIZE; i++) {
+            g_states[i] = switch_step(g_states[i], inputs[i], &g_actions[i]);
+        }
+    }
+    double baseline = now_seconds() - start;
+    report("switch per instance", baseline, rounds, baseline);
+
+    memset(g_states, IDLE, sizeof(g_states));
+    start = now_seconds();
+    for (long r = 0; r < rounds; r++) {
+        const uint8_t *inputs = g_inputs[r % INPUT_ROUNDS];
+        for (size_t i = 0; i < FLEET_SIZE; i++) {
+            g_states[i] = state_machine_step(&g_machine, g_states[i], inputs[i], &g_actions[i]);
+        }
+    }
+    report("state_machine_step", now_seconds() - start, rounds, baseline);
+
+    memset(g_states, IDLE, sizeof(g_states));
+    start = now_seconds();
+    for (long r = 0; r < rounds; r++) {
+        state_machine_step_batch(&g_machine, g_states, g_inputs[r % INPUT_ROUNDS], g_actions,
+                                 FLEET_SIZE);
+    }
+    report("state_machine_step_batch", now_seconds() - start, rounds, baseline);
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * BENCHMARK - Telemetry archive range queries
+ *
+ * Writes a synthetic archive (several sensors, one reading per sensor
+ * per second), then compares a full scan of the archive against short
+ * time-window queries that binary-search the block index.
+ *
+ * Usage: make bench   (or ./bench_telemetry_archive [samples] [path])
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "telemetry_archive.h"
+
+#define DEFAULT_BENCH_SAMPLES 4000000
+#define BENCH_SENSORS 8
+#define BENCH_QUERIES 1000
+#define BENCH_WINDOW_SECONDS 60
+#define BENCH_START_TIME 1700000000u
+
+/* Rule 3: everything is static */
+static TelemetryArchiveWriter g_writer;
+static TelemetryArchiveQuery g_query;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static bool write_archive(const char *path, size_t count) {
+    char idx[TELEMETRY_ARCHIVE_MAX_PATH];
+    snprintf(idx, sizeof(idx), "%s.idx", path);
+    (void)unlink(path);
+    (void)unlink(idx);
+
+    if (!telemetry_archive_writer_open(&g_writer, path)) {
+        return false;
+    }
+    double temperature[BENCH_SENSORS];
+    for (int s = 0; s < BENCH_SENSORS; s++) {
+        temperature[s] = 20.0 + s;
+    }
+    srand(42);
+    for (size_t i = 0; i < count; i++) {
+        int sensor = (int)(i % BENCH_SENSORS);
+        temperature[sensor] += (rand() % 5 - 2) * 0.01;
+        TelemetryData sample = {
+            sensor + 100,
+            (double)(long)(temperature[sensor] * 100.0) / 100.0,
+            BENCH_START_TIME + (uint32_t)(i / BENCH_SENSORS),
+            true,
+            0
+        };
+        if (!telemetry_archive_append(&g_writer, &sample)) {
+            (void)telemetry_archive_writer_close(&g_writer);
+            return false;
+        }
+    }
+    return telemetry_archive_writer_close(&g_writer);
+}
+
+/* Number of matching samples; adds their temperatures to checksum */
+static size_t run_query(const TelemetryArchive *archive, uint32_t from, uint32_t to,
+                        double *checksum) {
+    TelemetryData sample;
+    size_t found = 0;
+    telemetry_archive_query(&g_query, archive, from, to);
+    while (telemetry_archive_query_next(&g_query, &sample)) {
+        *checksum += sample.temperature;
+        found++;
+    }
+    return found;
+}
+
+int main(int argc, char **argv) {
+    size_t count = DEFAULT_BENCH_SAMPLES;
+    const char *path = "/tmp/bench_telemetry.tla";
+    if (argc > 1) {
+        count = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        path = argv[2];
+    }
+    if (count < BENCH_SENSORS) {
+        fprintf(stderr, "samples must be >= %d\n", BENCH_SENSORS);
+        return 1;
+    }
+
+    double start = now_seconds();
+    if (!write_archive(path, count)) {
+        fprintf(stderr, "cannot write archive %s\n", path);
+        return 1;
+    }
+    double write_time = now_seconds() - start;
+
+    TelemetryArchive archive;
+    if (!telemetry_archive_open(&archive, path)) {
+        fprintf(stderr, "cannot open archive %s\n", path);
+        return 1;
+    }
+
+    double checksum = 0.0;
+    start = now_seconds();
+    size_t scanned = run_query(&archive, 0, UINT32_MAX, &checksum);
+    double scan_time = now_seconds() - start;
+
+    const uint32_t span = (uint32_t)(count / BENCH_SENSORS);
+    size_t matched = 0;
+    srand(7);
+    start = now_seconds();
+    for (int q = 0; q < BENCH_QUERIES; q++) {
+        uint32_t from = BENCH_START_TIME + (uint32_t)rand() % span;
+        matched += run_query(&archive, from, from + BENCH_WINDOW_SECONDS - 1, &checksum);
+    }
+    double query_time = now_seconds() - start;
+
+    printf("Telemetry archive benchmark (%zu samples, %zu blocks, %.1f MB)\n",
+           count, archive.block_count, archive.data_size / 1e6);
+    printf("  Write:      %.1f Msamples/s\n", count / write_time / 1e6);
+    printf("  Full scan:  %zu samples in %.1f ms\n", scanned, scan_time * 1e3);
+    printf("  %ds window: %.1f us/query (%.0f samples each), checksum %.2f\n",
+           BENCH_WINDOW_SECONDS, query_time / BENCH_QUERIES * 1e6,
+           (double)matched / BENCH_QUERIES, checksum);
+    printf("  Speedup:    %.0fx vs full scan\n",
+           scan_time / (query_time / BENCH_QUERIES));
+
+    telemetry_archive_close(&archive);
+    return 0;
+}
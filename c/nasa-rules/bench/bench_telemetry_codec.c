@@ -0,0 +1,139 @@
+/*
+ * BENCHMARK - Telemetry columnar codec
+ *
+ * Encodes a synthetic telemetry stream (several sensors sampled at a
+ * steady rate with small temperature drift), decodes it back, and
+ * reports the compression ratio against CSV and raw records plus the
+ * encode/decode throughput.
+ *
+ * Usage: make bench   (or ./bench_telemetry_codec [samples])
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "telemetry_codec.h"
+#include "telemetry_csv.h"
+
+#define MAX_BENCH_SAMPLES 2000000
+#define DEFAULT_BENCH_SAMPLES 1000000
+#define BENCH_SENSORS 8
+
+/* Rule 3: everything is static */
+static TelemetryData g_samples[MAX_BENCH_SAMPLES];
+static uint8_t g_stream[(MAX_BENCH_SAMPLES / TELEMETRY_BLOCK_SAMPLES + 1) * TELEMETRY_BLOCK_MAX_BYTES];
+static TelemetryEncoder g_encoder;
+static TelemetryDecoder g_decoder;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void generate_samples(size_t count) {
+    double temperature[BENCH_SENSORS];
+    for (int s = 0; s < BENCH_SENSORS; s++) {
+        temperature[s] = 20.0 + s;
+    }
+
+    uint32_t timestamp = 1700000000u;
+    srand(42);
+    for (size_t i = 0; i < count; i++) {
+        int sensor = (int)(i % BENCH_SENSORS);
+        if (sensor == 0) {
+            timestamp++;  // One reading per sensor per second
+        }
+        // Sensors report with 0.01 resolution and drift slowly
+        temperature[sensor] += (rand() % 5 - 2) * 0.01;
+        double quantized = (double)(long)(temperature[sensor] * 100.0) / 100.0;
+        g_samples[i] = (TelemetryData){ sensor + 100, quantized, timestamp, true, 0 };
+    }
+}
+
+static size_t encode_all(size_t count) {
+    size_t bytes = 0;
+    telemetry_encoder_reset(&g_encoder);
+    for (size_t i = 0; i < count; i++) {
+        if (!telemetry_encoder_add(&g_encoder, &g_samples[i])) {
+            bytes += telemetry_encoder_finish(&g_encoder, &g_stream[bytes], sizeof(g_stream) - bytes);
+            telemetry_encoder_reset(&g_encoder);
+            (void)telemetry_encoder_add(&g_encoder, &g_samples[i]);
+        }
+    }
+    if (telemetry_encoder_count(&g_encoder) > 0) {
+        bytes += telemetry_encoder_finish(&g_encoder, &g_stream[bytes], sizeof(g_stream) - bytes);
+    }
+    return bytes;
+}
+
+static size_t decode_all(size_t bytes, double *checksum) {
+    size_t decoded = 0;
+    size_t offset = 0;
+    *checksum = 0.0;
+    while (offset < bytes && telemetry_decoder_open(&g_decoder, &g_stream[offset], bytes - offset)) {
+        TelemetryData sample;
+        while (telemetry_decoder_next(&g_decoder, &sample)) {
+            *checksum += sample.temperature;
+            decoded++;
+        }
+        offset += telemetry_decoder_block_size(&g_decoder);
+    }
+    return decoded;
+}
+
+static size_t csv_size(size_t count) {
+    char line[TELEMETRY_CSV_MAX_LINE];
+    size_t bytes = 0;
+    for (size_t i = 0; i < count; i++) {
+        bytes += telemetry_csv_format_line(line, g_samples[i].sensor_id,
+                                           g_samples[i].temperature, g_samples[i].timestamp);
+    }
+    return bytes;
+}
+
+int main(int argc, char **argv) {
+    size_t count = DEFAULT_BENCH_SAMPLES;
+    if (argc > 1) {
+        count = strtoul(argv[1], NULL, 10);
+    }
+    if (count == 0 || count > MAX_BENCH_SAMPLES) {
+        fprintf(stderr, "samples must be in 1..%d\n", MAX_BENCH_SAMPLES);
+        return 1;
+    }
+
+    generate_samples(count);
+
+    const size_t raw_bytes = count * (sizeof(int32_t) + sizeof(double) + sizeof(uint32_t));
+    const size_t text_bytes = csv_size(count);
+
+    double start = now_seconds();
+    size_t encoded_bytes = encode_all(count);
+    double encode_time = now_seconds() - start;
+
+    double checksum = 0.0;
+    start = now_seconds();
+    size_t decoded = decode_all(encoded_bytes, &checksum);
+    double decode_time = now_seconds() - start;
+
+    if (decoded != count) {
+        fprintf(stderr, "decoded %zu of %zu samples\n", decoded, count);
+        return 1;
+    }
+
+    printf("Telemetry codec benchmark (%zu samples, %d sensors)\n", count, BENCH_SENSORS);
+    printf("  CSV:      %10zu bytes (%.2f B/sample)\n", text_bytes, (double)text_bytes / count);
+    printf("  Raw:      %10zu bytes (%.2f B/sample)\n", raw_bytes, (double)raw_bytes / count);
+    printf("  Encoded:  %10zu bytes (%.2f B/sample)\n", encoded_bytes, (double)encoded_bytes / count);
+    printf("  Ratio:    %.1fx vs CSV, %.1fx vs raw\n",
+           (double)text_bytes / encoded_bytes, (double)raw_bytes / encoded_bytes);
+    printf("  Encode:   %.1f MB/s raw (%.1f Msamples/s)\n",
+           raw_bytes / encode_time / 1e6, count / encode_time / 1e6);
+    printf("  Decode:   %.1f MB/s raw (%.1f Msamples/s), checksum %.2f\n",
+           raw_bytes / decode_time / 1e6, count / decode_time / 1e6, checksum);
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * BENCHMARK - Quantized telemetry history
+ *
+ * Fills a full TelemetryQuantized store (16k samples) in each format and
+ * compares it with the same samples kept as TelemetryData:
+ *   memory    bytes per sample
+ *   append    ns per sample (block sealing included)
+ *   mean      whole-history mean: strided doubles out of the structs vs
+ *             telemetry_quantized_sum (per-block SIMD decode + reduction)
+ *   error     worst quantization error measured by the store
+ *
+ * Usage: make bench   (or ./bench_telemetry_quantized [rounds])
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "telemetry_quantized.h"
+
+#define DEFAULT_BENCH_ROUNDS 2000
+#define HISTORY_SAMPLES (TELEMETRY_QUANTIZED_BLOCKS * TELEMETRY_QUANTIZED_BLOCK)
+
+static TelemetryData plain[HISTORY_SAMPLES];
+static TelemetryQuantized store;
+static volatile double sink;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void make_samples(void) {
+    for (size_t i = 0; i < HISTORY_SAMPLES; i++) {
+        plain[i] = (TelemetryData){
+            .sensor_id = (int)(i % 32),
+            .temperature = 20.0 + 5.0 * sin((double)i * 0.001) + (double)(i % 7) * 0.01,
+            .timestamp = 1700000000u + (uint32_t)(i / 16),
+            .valid = true,
+            .time_ns = i * 62500000ull
+        };
+    }
+}
+
+static double mean_plain(void) {
+    double sum = 0.0;
+    for (size_t i = 0; i < HISTORY_SAMPLES; i++) {
+        sum += plain[i].temperature;
+    }
+    return sum / HISTORY_SAMPLES;
+}
+
+static double mean_quantized(void) {
+    return telemetry_quantized_sum(&store) / (double)telemetry_quantized_count(&store);
+}
+
+static void run_format(TelemetryQuantizedFormat format, const char *name, long rounds) {
+    uint64_t start = now_ns();
+    for (long r = 0; r < rounds / 100 + 1; r++) {
+        telemetry_quantized_init(&store, format);
+        for (size_t i = 0; i < HISTORY_SAMPLES; i++) {
+            (void)telemetry_quantized_append(&store, &plain[i]);
+        }
+    }
+    double append_ns = (double)(now_ns() - start) /
+                       (double)((rounds / 100 + 1) * HISTORY_SAMPLES);
+
+    start = now_ns();
+    for (long r = 0; r < rounds; r++) {
+        sink = mean_quantized();
+    }
+    double mean_us = (double)(now_ns() - start) / (double)rounds / 1000.0;
+
+    printf("  %-8s %5.2f B/sample  append %5.1f ns  mean %7.1f us (%.6f, error <= %.1e)\n",
+           name, (double)sizeof(store) / HISTORY_SAMPLES, append_ns, mean_us, sink,
+           telemetry_quantized_max_error(&store));
+}
+
+int main(int argc, char **argv) {
+    long rounds = DEFAULT_BENCH_ROUNDS;
+    if (argc > 1) {
+        rounds = strtol(argv[1], NULL, 10);
+    }
+    make_samples();
+
+    printf("Quantized history: %d samples, %ld mean computations\n", HISTORY_SAMPLES, rounds);
+    uint64_t start = now_ns();
+    for (long r = 0; r < rounds; r++) {
+        sink = mean_plain();
+    }
+    printf("  %-8s %5.2f B/sample  append   n/a     mean %7.1f us (%.6f)\n", "plain",
+           (double)sizeof(plain) / HISTORY_SAMPLES,
+           (double)(now_ns() - start) / (double)rounds / 1000.0, sink);
+
+    run_format(TELEMETRY_QUANTIZED_INT16, "int16", rounds);
+    run_format(TELEMETRY_QUANTIZED_FLOAT16, "float16", rounds);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,163 @@
+/*
+ * BENCHMARK - Multi-producer telemetry ring
+ *
+ * N producer threads publish samples while one reader thread takes
+ * snapshots of the latest 100. Compares the lock-free ring against the
+ * same overwrite ring guarded by one pthread mutex, and checks that no
+ * snapshot ever contains a torn sample.
+ *
+ * Usage: make bench   (or ./bench_telemetry_ring [samples_per_producer])
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "telemetry_ring.h"
+
+#define DEFAULT_SAMPLES_PER_PRODUCER 1000000
+#define MAX_PRODUCERS 8
+#define SNAPSHOT_SIZE 100
+
+typedef enum { RING_LOCK_FREE, RING_MUTEX } RingKind;
+
+/* Baseline: the same overwrite ring behind one lock */
+typedef struct {
+    pthread_mutex_t lock;
+    uint64_t head;
+    TelemetryData samples[TELEMETRY_RING_CAPACITY];
+} MutexRing;
+
+static TelemetryRing lock_free_ring;
+static MutexRing mutex_ring = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+typedef struct {
+    int producers;   /* Stop once this many producers finished */
+    long snapshots;  /* Out: snapshots taken */
+} ReaderArgs;
+
+static RingKind bench_kind;
+static long samples_per_producer;
+static _Atomic int producers_done;
+static _Atomic long torn_samples;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void mutex_publish(const TelemetryData *sample) {
+    pthread_mutex_lock(&mutex_ring.lock);
+    mutex_ring.samples[mutex_ring.head % TELEMETRY_RING_CAPACITY] = *sample;
+    mutex_ring.head++;
+    pthread_mutex_unlock(&mutex_ring.lock);
+}
+
+static size_t mutex_snapshot(TelemetryData *out, size_t max) {
+    pthread_mutex_lock(&mutex_ring.lock);
+    size_t n = (mutex_ring.head < max) ? (size_t)mutex_ring.head : max;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t ticket = mutex_ring.head - n + i;
+        out[i] = mutex_ring.samples[ticket % TELEMETRY_RING_CAPACITY];
+    }
+    pthread_mutex_unlock(&mutex_ring.lock);
+    return n;
+}
+
+/* Every field is derived from one counter: a torn copy mixes two */
+static TelemetryData make_sample(int producer, long i) {
+    TelemetryData sample = {
+        .sensor_id = producer,
+        .temperature = (double)i,
+        .timestamp = (uint32_t)i,
+        .valid = true,
+        .time_ns = (uint64_t)i
+    };
+    return sample;
+}
+
+static bool is_torn(const TelemetryData *sample) {
+    return sample->temperature != (double)sample->time_ns ||
+           sample->timestamp != (uint32_t)sample->time_ns || !sample->valid;
+}
+
+static void *producer_main(void *arg) {
+    int producer = (int)(intptr_t)arg;
+    for (long i = 0; i < samples_per_producer; i++) {
+        TelemetryData sample = make_sample(producer, i);
+        if (bench_kind == RING_LOCK_FREE) {
+            (void)telemetry_ring_publish(&lock_free_ring, &sample);
+        } else {
+            mutex_publish(&sample);
+        }
+    }
+    atomic_fetch_add(&producers_done, 1);
+    return NULL;
+}
+
+static void *reader_main(void *arg) {
+    ReaderArgs *args = arg;
+    static TelemetryData out[SNAPSHOT_SIZE];
+    while (atomic_load(&producers_done) < args->producers) {
+        size_t n = (bench_kind == RING_LOCK_FREE)
+                       ? telemetry_ring_snapshot(&lock_free_ring, out, SNAPSHOT_SIZE)
+                       : mutex_snapshot(out, SNAPSHOT_SIZE);
+        for (size_t i = 0; i < n; i++) {
+            if (is_torn(&out[i])) {
+                atomic_fetch_add(&torn_samples, 1);
+            }
+        }
+        args->snapshots++;
+    }
+    return NULL;
+}
+
+static void run(RingKind kind, int producers) {
+    bench_kind = kind;
+    atomic_store(&producers_done, 0);
+    telemetry_ring_init(&lock_free_ring);
+    mutex_ring.head = 0;
+
+    pthread_t threads[MAX_PRODUCERS];
+    pthread_t reader;
+    ReaderArgs reader_args = { .producers = producers, .snapshots = 0 };
+
+    double start = now_seconds();
+    pthread_create(&reader, NULL, reader_main, &reader_args);
+    for (int p = 0; p < producers; p++) {
+        pthread_create(&threads[p], NULL, producer_main, (void *)(intptr_t)p);
+    }
+    for (int p = 0; p < producers; p++) {
+        pthread_join(threads[p], NULL);
+    }
+    double elapsed = now_seconds() - start;
+    pthread_join(reader, NULL);
+
+    double total = (double)samples_per_producer * producers;
+    printf("  %-9s %d producers: %7.2f Msamples/s  %8ld snapshots  dropped %llu\n",
+           (kind == RING_LOCK_FREE) ? "lock-free" : "mutex", producers,
+           total / elapsed / 1e6, reader_args.snapshots,
+           (kind == RING_LOCK_FREE)
+               ? (unsigned long long)telemetry_ring_dropped(&lock_free_ring) : 0ull);
+}
+
+int main(int argc, char **argv) {
+    samples_per_producer = DEFAULT_SAMPLES_PER_PRODUCER;
+    if (argc > 1) {
+        samples_per_producer = strtol(argv[1], NULL, 10);
+    }
+
+    printf("Telemetry ring: %ld samples per producer, snapshots of %d\n",
+           samples_per_producer, SNAPSHOT_SIZE);
+    const int producer_counts[] = {1, 2, 4};
+    for (size_t i = 0; i < sizeof(producer_counts) / sizeof(producer_counts[0]); i++) {
+        run(RING_LOCK_FREE, producer_counts[i]);
+        run(RING_MUTEX, producer_counts[i]);
+    }
+    printf("  torn samples seen by readers: %ld\n", atomic_load(&torn_samples));
+    return atomic_load(&torn_samples) == 0 ? 0 : 1;
+}
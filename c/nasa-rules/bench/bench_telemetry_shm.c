@@ -0,0 +1,179 @@
+/*
+ * BENCHMARK - Shared-memory telemetry publication
+ *
+ * A forked reader process maps the segment read-only and follows the
+ * ring while the parent publishes bursts of samples:
+ *   publish   producer cost per sample, without and with the reader
+ *   latency   publish -> seen by the other process (sample time_ns vs
+ *             the reader's CLOCK_MONOTONIC), mean / p99 / worst
+ * On a single core the latency is dominated by when the scheduler runs
+ * the reader, not by the ring.
+ *
+ * Usage: make bench   (or ./bench_telemetry_shm [bursts])
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "telemetry_shm.h"
+
+#define BENCH_SHM_NAME "/bench_telemetry_shm"
+#define DEFAULT_BENCH_BURSTS 2000
+#define BURST_SAMPLES 64
+#define BURST_PERIOD_NS 200000L  /* 320k samples/s while bursting */
+#define END_SENSOR -1            /* Sentinel: the producer is done */
+#define LATENCY_BUCKETS 64       /* Power-of-two ns buckets */
+
+static TelemetryShmPublisher publisher;
+static TelemetryData batch[256];
+static uint64_t histogram[LATENCY_BUCKETS];
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void record(uint64_t ns) {
+    int bucket = 0;
+    while (bucket < LATENCY_BUCKETS - 1 && (1ull << (bucket + 1)) <= ns) {
+        bucket++;
+    }
+    histogram[bucket]++;
+}
+
+/* Upper bound of the bucket holding the q-quantile */
+static uint64_t quantile(uint64_t samples, double q) {
+    uint64_t target = (uint64_t)(q * (double)samples);
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < LATENCY_BUCKETS; bucket++) {
+        seen += histogram[bucket];
+        if (seen > target) {
+            return 1ull << (bucket + 1);
+        }
+    }
+    return UINT64_MAX;
+}
+
+static int run_reader(int ready_fd) {
+    TelemetryShmReader reader;
+    if (!telemetry_shm_open(&reader, BENCH_SHM_NAME)) {
+        return EXIT_FAILURE;
+    }
+    uint64_t lost = 0;
+    // Skip what the no-reader pass left in the ring: measure live samples
+    for (size_t round = 0; round <= TELEMETRY_RING_CAPACITY / 256; round++) {
+        (void)telemetry_shm_read(&reader, batch, sizeof(batch) / sizeof(batch[0]), &lost);
+    }
+    lost = 0;
+    (void)write(ready_fd, "r", 1);
+    close(ready_fd);
+
+    uint64_t seen = 0;
+    uint64_t total_ns = 0;
+    uint64_t worst_ns = 0;
+    bool done = false;
+    while (!done) {
+        size_t n = telemetry_shm_read(&reader, batch, sizeof(batch) / sizeof(batch[0]), &lost);
+        uint64_t now = now_ns();
+        for (size_t i = 0; i < n; i++) {
+            if (batch[i].sensor_id == END_SENSOR) {
+                done = true;
+                break;
+            }
+            uint64_t latency = now - batch[i].time_ns;
+            total_ns += latency;
+            worst_ns = (latency > worst_ns) ? latency : worst_ns;
+            record(latency);
+            seen++;
+        }
+        if (n == 0) {
+            (void)sched_yield();
+        }
+    }
+
+    printf("  latency  %8.1f us mean  p99 < %8.1f us  worst %8.1f us  (%llu seen, %llu lost)\n",
+           seen ? (double)total_ns / (double)seen / 1000.0 : 0.0,
+           (double)quantile(seen, 0.99) / 1000.0, (double)worst_ns / 1000.0,
+           (unsigned long long)seen, (unsigned long long)lost);
+    fflush(stdout);  // The child leaves through _exit()
+    telemetry_shm_reader_close(&reader);
+    return EXIT_SUCCESS;
+}
+
+/* Publish bursts; returns producer ns per sample (pacing excluded) */
+static double publish_bursts(TelemetryRing *ring, long bursts) {
+    const struct timespec pause = {0, BURST_PERIOD_NS};
+    uint64_t busy_ns = 0;
+    for (long b = 0; b < bursts; b++) {
+        uint64_t start = now_ns();
+        for (int i = 0; i < BURST_SAMPLES; i++) {
+            TelemetryData sample = {
+                .sensor_id = i % 16,
+                .temperature = 20.0 + (double)i / 10.0,
+                .timestamp = 1700000000u,
+                .valid = true,
+                .time_ns = now_ns()
+            };
+            (void)telemetry_ring_publish(ring, &sample);
+        }
+        busy_ns += now_ns() - start;
+        nanosleep(&pause, NULL);
+    }
+    return (double)busy_ns / (double)(bursts * BURST_SAMPLES);
+}
+
+int main(int argc, char **argv) {
+    long bursts = DEFAULT_BENCH_BURSTS;
+    if (argc > 1) {
+        bursts = strtol(argv[1], NULL, 10);
+    }
+
+    printf("Shared-memory ring: %ld bursts of %d samples, one reader process\n", bursts,
+           BURST_SAMPLES);
+    if (!telemetry_shm_create(&publisher, BENCH_SHM_NAME)) {
+        printf("  shm_open failed\n");
+        return EXIT_FAILURE;
+    }
+    TelemetryRing *ring = telemetry_shm_ring(&publisher);
+
+    printf("  publish  %8.1f ns/sample (no reader)\n", publish_bursts(ring, bursts / 4 + 1));
+
+    int ready[2];
+    if (pipe(ready) != 0) {
+        telemetry_shm_close(&publisher, true);
+        return EXIT_FAILURE;
+    }
+    fflush(stdout);
+    pid_t child = fork();
+    if (child == 0) {
+        close(ready[0]);
+        _exit(run_reader(ready[1]));
+    }
+    close(ready[1]);
+    char byte;
+    if (child < 0 || read(ready[0], &byte, 1) != 1) {
+        printf("  reader did not start\n");
+        telemetry_shm_close(&publisher, true);
+        return EXIT_FAILURE;
+    }
+    close(ready[0]);
+
+    double cost = publish_bursts(ring, bursts);
+    TelemetryData end = {.sensor_id = END_SENSOR, .valid = false, .time_ns = now_ns()};
+    (void)telemetry_ring_publish(ring, &end);
+    printf("  publish  %8.1f ns/sample (reader attached)\n", cost);
+    fflush(stdout);
+
+    int status = 0;
+    (void)waitpid(child, &status, 0);
+    telemetry_shm_close(&publisher, true);
+    return (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
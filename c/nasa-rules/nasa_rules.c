@@ -5,12 +5,36 @@
  * Compilation: gcc -Wall -Wextra -Werror -pedantic -std=c11 nasa_rules.c
  */
 
+#define _POSIX_C_SOURCE 200809L  // strnlen
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <assert.h>
 #include <string.h>
+#include <math.h>
+
+#include "async_io.h"
+#include "clock_source.h"
+#include "reduce.h"
+#include "selection.h"
+#include "sensor_registry.h"
+#include "sensor_stats.h"
+#include "sort_engine.h"
+#include "telemetry_archive.h"
+#include "telemetry_async_writer.h"
+#include "telemetry_codec.h"
+#include "telemetry_csv.h"
+#include "telemetry_downsample.h"
+#include "telemetry_persist.h"
+#include "telemetry_quantized.h"
+#include "telemetry_ring.h"
+#include "telemetry_rollup.h"
+#include "telemetry_shm.h"
+#include "telemetry_types.h"
+#include "telemetry_validate.h"
+#include "telemetry_window.h"
 
 // ============================================
 // RULE 1: RESTRICT CONTROL FLOW
@@ -102,7 +126,7 @@ int sum_array(const int *array, size_t size) {
 // No malloc/free after initialization phase
 // ============================================
 
-#define MAX_SENSORS 10
+#define MAX_SENSORS SENSOR_REGISTRY_CAPACITY
 
 /* ❌ BAD: Dynamic allocation in runtime */
 typedef struct {
@@ -131,32 +155,30 @@ void good_init_buffer(GoodBuffer *buf) {
     memset(buf->data, 0, sizeof(buf->data));
 }
 
-/* ✅ GOOD: Pre-allocated pool */
-typedef struct {
-    int id;
-    int value;
-    bool active;
-} Sensor;
-
-typedef struct {
-    Sensor sensors[MAX_SENSORS];
-    size_t count;
-} SensorPool;
+/* ✅ GOOD: Pre-allocated pool (tables sized for MAX_SENSORS up front)
+ * Sensor/SensorRegistry are defined in telemetry/sensor_registry.h:
+ * O(1) id lookup, O(1) swap-remove, generation-checked handles */
+static SensorRegistry sensor_pool;
+static bool sensor_pool_ready = false;
 
-static SensorPool sensor_pool = {0};
+static SensorRegistry *get_sensor_pool(void) {
+    if (!sensor_pool_ready) {
+        sensor_registry_init(&sensor_pool);  // Init phase, no malloc
+        sensor_pool_ready = true;
+    }
+    return &sensor_pool;
+}
 
 bool sensor_pool_add(int id, int value) {
-    if (sensor_pool.count >= MAX_SENSORS) {
-        return false;  // Pool full
-    }
-    
-    Sensor *sensor = &sensor_pool.sensors[sensor_pool.count];
-    sensor->id = id;
-    sensor->value = value;
-    sensor->active = true;
-    sensor_pool.count++;
-    
-    return true;
+    return sensor_registry_add(get_sensor_pool(), id, value, NULL);  // Pool full or duplicate
+}
+
+bool sensor_pool_remove(int id) {
+    return sensor_registry_remove(get_sensor_pool(), id);
+}
+
+Sensor *sensor_pool_find(int id) {
+    return sensor_registry_find(get_sensor_pool(), id);
 }
 
 // ============================================
@@ -202,32 +224,26 @@ void sort_array(int *data, size_t size) {
     assert(data != NULL);
     assert(size <= BUFFER_SIZE);
     
-    for (size_t i = 0; i < size - 1; i++) {
-        for (size_t j = 0; j < size - i - 1; j++) {
-            if (data[j] > data[j + 1]) {
-                swap_integers(&data[j], &data[j + 1]);
-            }
-        }
-    }
+    // Introsort with an explicit bounded stack: no recursion (Rule 1)
+    sort_int(data, size);
 }
 
 int calculate_mean(const int *data, size_t size) {
     assert(data != NULL);
     assert(size > 0);
     
-    long sum = 0;
-    for (size_t i = 0; i < size; i++) {
-        sum += data[i];
-    }
+    // 64-bit accumulation: no overflow for any BUFFER_SIZE of ints
+    int64_t sum = reduce_sum_int(data, size);
     
-    return (int)(sum / size);
+    return (int)(sum / (int64_t)size);
 }
 
-int find_median(const int *sorted_data, size_t size) {
-    assert(sorted_data != NULL);
+/* Introselect: expected O(n), no full sort needed. Reorders data. */
+int find_median(int *data, size_t size) {
+    assert(data != NULL);
     assert(size > 0);
     
-    return sorted_data[size / 2];
+    return select_kth_int(data, size, size / 2);
 }
 
 // ============================================
@@ -284,9 +300,8 @@ bool safe_copy_buffer(char *dest, const char *src, size_t dest_size) {
         return false;  // Would overflow
     }
     
-    // Use safe string copy
-    strncpy(dest, src, dest_size - 1);
-    dest[dest_size - 1] = '\0';  // Ensure null termination
+    // Copy including the terminator; no zero-fill of the rest of dest
+    memcpy(dest, src, src_len + 1);
     
     return true;
 }
@@ -465,13 +480,8 @@ const char* state_to_string(State state) {
  * - Resource leaks
  */
 
-/* ✅ GOOD: Code that passes static analysis */
-typedef struct {
-    int sensor_id;
-    double temperature;
-    uint32_t timestamp;
-    bool valid;
-} TelemetryData;
+/* ✅ GOOD: Code that passes static analysis
+ * (TelemetryData is defined in telemetry/telemetry_types.h) */
 
 Status process_telemetry(TelemetryData *data) {
     // Check preconditions (static analyzer verifies)
@@ -485,7 +495,7 @@ Status process_telemetry(TelemetryData *data) {
     }
     
     // Process within safe bounds
-    if (data->temperature < -273.15 || data->temperature > 1000.0) {
+    if (data->temperature < TELEMETRY_TEMP_MIN || data->temperature > TELEMETRY_TEMP_MAX) {
         data->valid = false;
         return STATUS_INVALID_DATA;
     }
@@ -494,6 +504,15 @@ Status process_telemetry(TelemetryData *data) {
     return STATUS_OK;
 }
 
+/* ✅ GOOD: Same range check for a whole column, no branch per sample.
+ * valid_bitmap needs TELEMETRY_BITMAP_WORDS(n) words; returns valid count */
+size_t process_telemetry_batch(const double *temps, size_t n, uint64_t *valid_bitmap) {
+    assert(temps != NULL || n == 0);          // Rule 7
+    assert(valid_bitmap != NULL || n == 0);
+    
+    return telemetry_validate_batch(temps, n, valid_bitmap);
+}
+
 // ============================================
 // COMPLETE EXAMPLE: Spacecraft Telemetry System
 // Applying all 10 rules
@@ -501,96 +520,744 @@ Status process_telemetry(TelemetryData *data) {
 
 #define MAX_TELEMETRY_SAMPLES 100
 
+/* Sliding window: once full, each new sample overwrites the oldest */
 typedef struct {
     TelemetryData samples[MAX_TELEMETRY_SAMPLES];
-    size_t count;
-    double running_average;
+    size_t head;            // Next slot to write
+    size_t count;           // Live samples, <= MAX_TELEMETRY_SAMPLES
+    uint64_t total;         // Samples ever buffered, the archive's high-water mark
+    TelemetryWindow stats;  // O(1) mean/variance/min/max of the window
 } TelemetryBuffer;
 
 static TelemetryBuffer telemetry_buffer = {0};  // Rule 3: Static allocation
 
-/* Rule 4: Function < 60 lines */
-Status add_telemetry_sample(int sensor_id, double temperature) {
+/* Rule 4: Small function - i-th sample, oldest first */
+static const TelemetryData *telemetry_sample_at(size_t i) {
+    assert(i < telemetry_buffer.count);  // Rule 7
+    
+    size_t oldest = (telemetry_buffer.head + MAX_TELEMETRY_SAMPLES
+                     - telemetry_buffer.count) % MAX_TELEMETRY_SAMPLES;
+    return &telemetry_buffer.samples[(oldest + i) % MAX_TELEMETRY_SAMPLES];
+}
+
+/* Rule 3: Timestamp source of the telemetry subsystem. The default,
+ * CACHED, costs one precise read per add_telemetry_batch() call instead
+ * of one per sample; a lone add_telemetry_sample() refreshes it itself,
+ * so its timestamps are never stale. */
+#define TELEMETRY_CLOCK_DEFAULT CLOCK_SOURCE_CACHED
+
+static ClockSource telemetry_clock;
+static bool telemetry_clock_ready = false;
+
+/* Rule 5: Returns STATUS_INVALID_DATA if the kind fell back to MONOTONIC */
+Status select_telemetry_clock(ClockSourceKind kind) {
+    bool exact = clock_source_init(&telemetry_clock, kind);
+    telemetry_clock_ready = true;
+    return exact ? STATUS_OK : STATUS_INVALID_DATA;
+}
+
+/* Rule 4: Capture time of a reading taken now (owner thread only) */
+static uint64_t read_telemetry_clock(void) {
+    if (!telemetry_clock_ready) {
+        (void)select_telemetry_clock(TELEMETRY_CLOCK_DEFAULT);  // Falls back silently
+    }
+    if (telemetry_clock.kind == CLOCK_SOURCE_CACHED) {
+        return clock_source_refresh(&telemetry_clock);
+    }
+    return clock_source_now(&telemetry_clock);
+}
+
+/* Rule 3: Background CSV log, two static 4096-sample buffers */
+static TelemetryAsyncWriter telemetry_log;
+static bool telemetry_log_running = false;
+
+/* Rule 5: Every buffered sample is also logged to filename from now on */
+Status start_telemetry_logging(const char *filename) {
+    assert(filename != NULL && !telemetry_log_running);  // Rule 7
+    
+    if (!telemetry_async_open(&telemetry_log, filename)) {
+        return STATUS_FILE_ERROR;
+    }
+    telemetry_log_running = true;
+    return STATUS_OK;
+}
+
+/* Rule 5: Write what is queued and stop; stats may be NULL */
+Status stop_telemetry_logging(TelemetryAsyncStats *stats) {
+    assert(telemetry_log_running);  // Rule 7
+    
+    bool ok = telemetry_async_close(&telemetry_log);
+    telemetry_log_running = false;
+    if (stats != NULL) {
+        telemetry_async_get_stats(&telemetry_log, stats);
+    }
+    return ok ? STATUS_OK : STATUS_FILE_ERROR;
+}
+
+/* Rule 4: Hand a partial log buffer to the writer once
+ * TELEMETRY_ASYNC_FLUSH_MS have passed, even when no sample arrives to
+ * trigger it. Called from the periodic entry points (batches, drains,
+ * getters), which run on the thread that buffers the samples. */
+static void poll_telemetry_logging(void) {
+    if (telemetry_log_running) {
+        telemetry_async_poll(&telemetry_log);
+    }
+}
+
+/* Rule 3: Journal state; the samples live in the mapped file */
+static TelemetryPersist telemetry_persist;
+static bool telemetry_persist_running = false;
+
+/* Rule 3: Optional long history, ~6 bytes per sample (16k samples) */
+static TelemetryQuantized telemetry_history;
+static bool telemetry_history_running = false;
+
+/* Rule 3: Long-horizon retention: raw minute, 1 s / 1 min / 1 h buckets */
+static TelemetryRollup telemetry_rollup;  // Zeroed: empty
+
+/* Rule 4: Small function - append to the window, O(1) per sample */
+static void buffer_telemetry_sample(const TelemetryData *incoming) {
+    TelemetryData *sample = &telemetry_buffer.samples[telemetry_buffer.head];
+    
+    // Window full: the slot holds the oldest sample, retire it first
+    if (telemetry_buffer.count == MAX_TELEMETRY_SAMPLES) {
+        telemetry_window_evict(&telemetry_buffer.stats, sample->temperature);
+    } else {
+        telemetry_buffer.count++;
+    }
+    
+    *sample = *incoming;
+    telemetry_buffer.head = (telemetry_buffer.head + 1) % MAX_TELEMETRY_SAMPLES;
+    telemetry_buffer.total++;
+    telemetry_window_add(&telemetry_buffer.stats, incoming->temperature);
+    
+    // Never blocks on the disk; a dropped batch shows in the logging stats
+    if (telemetry_log_running) {
+        (void)telemetry_async_append(&telemetry_log, incoming);
+    }
+    // A store into the mapped journal; survives a crash of this process
+    if (telemetry_persist_running) {
+        telemetry_persist_append(&telemetry_persist, incoming);
+    }
+    telemetry_rollup_add(&telemetry_rollup, incoming);  // O(1): one bucket per level
+    if (telemetry_history_running) {
+        (void)telemetry_quantized_append(&telemetry_history, incoming);  // Valid ones only
+    }
+    
+    // Rule 7: Assert postcondition
+    assert(telemetry_buffer.count <= MAX_TELEMETRY_SAMPLES);
+    assert(telemetry_buffer.stats.count == telemetry_buffer.count);
+}
+
+/* Rule 3: Per-sensor aggregates; a zeroed SensorStats is an empty table */
+static SensorStats sensor_stats;
+
+/* Rule 4: Small function - per-sensor view of everything ingested */
+Status get_sensor_stats(int sensor_id, SensorGroupStats *out) {
+    assert(out != NULL);  // Rule 7
+    poll_telemetry_logging();
+    
+    const SensorGroupStats *group = sensor_stats_find(&sensor_stats, sensor_id);
+    if (group == NULL) {
+        return STATUS_INVALID_DATA;
+    }
+    *out = *group;
+    return STATUS_OK;
+}
+
+/* Rule 4: Function < 60 lines, O(1) per sample */
+static Status record_telemetry_sample(int sensor_id, double temperature, uint64_t now_ns) {
     // Rule 7: Assert preconditions
     assert(sensor_id >= 0);
     
-    // Rule 2: Fixed loop bounds check
-    if (telemetry_buffer.count >= MAX_TELEMETRY_SAMPLES) {
+    // Non-finite values would corrupt the running sums
+    if (!isfinite(temperature)) {
         return STATUS_INVALID_DATA;
     }
     
     // Rule 6: Minimal scope
-    TelemetryData *sample = &telemetry_buffer.samples[telemetry_buffer.count];
+    TelemetryData sample = {
+        .sensor_id = sensor_id,
+        .temperature = temperature,
+        .timestamp = clock_source_unix_seconds(now_ns),
+        .valid = true,
+        .time_ns = now_ns
+    };
+    buffer_telemetry_sample(&sample);
     
-    // Initialize data
-    sample->sensor_id = sensor_id;
-    sample->temperature = temperature;
-    sample->timestamp = (uint32_t)time(NULL);
-    sample->valid = true;
+    if (!sensor_stats_update(&sensor_stats, &sample)) {  // Rule 5
+        return STATUS_INVALID_DATA;  // Too many sensors; still in the window
+    }
     
-    telemetry_buffer.count++;
+    return STATUS_OK;
+}
+
+/* Rule 5: One reading, stamped now */
+Status add_telemetry_sample(int sensor_id, double temperature) {
+    return record_telemetry_sample(sensor_id, temperature, read_telemetry_clock());
+}
+
+/* Rule 4: Add readings taken together; with CLOCK_SOURCE_CACHED (the
+ * default) they share one clock read */
+Status add_telemetry_batch(const int *sensor_ids, const double *temperatures,
+                           size_t count) {
+    assert(sensor_ids != NULL && temperatures != NULL);  // Rule 7
+    poll_telemetry_logging();
     
-    // Update running average
-    recalculate_average();  // Rule 4: Small functions
+    uint64_t batch_ns = read_telemetry_clock();
+    bool shared = (telemetry_clock.kind == CLOCK_SOURCE_CACHED);
     
-    // Rule 7: Assert postcondition
-    assert(telemetry_buffer.count <= MAX_TELEMETRY_SAMPLES);
+    // Rule 2: Bounded by count
+    for (size_t i = 0; i < count; i++) {
+        uint64_t now_ns = (shared || i == 0) ? batch_ns : clock_source_now(&telemetry_clock);
+        Status status = record_telemetry_sample(sensor_ids[i], temperatures[i], now_ns);
+        if (status != STATUS_OK) {  // Rule 5: Check return
+            return status;
+        }
+    }
+    
+    return STATUS_OK;
+}
+
+// ============================================
+// ROLLUPS: everything buffered, at 1 s / 1 min / 1 h
+// ============================================
+
+/* Rule 5: Count/mean/min/max of the samples stamped in [from, to) (Unix
+ * seconds), from the coarsest buckets that fit; STATUS_INVALID_DATA if none */
+Status get_telemetry_summary(uint32_t from, uint32_t to, TelemetryRollupSummary *out) {
+    assert(out != NULL && from <= to);  // Rule 7
+    poll_telemetry_logging();
+    
+    telemetry_rollup_summarize(&telemetry_rollup, from, to, out);
+    return (out->count > 0) ? STATUS_OK : STATUS_INVALID_DATA;
+}
+
+// ============================================
+// QUANTIZED HISTORY: window -> int16/float16 blocks
+// ============================================
+
+/* Rule 4: Keep every buffered sample from now on, quantized per block */
+void start_telemetry_history(TelemetryQuantizedFormat format) {
+    assert(!telemetry_history_running);  // Rule 7
+    
+    telemetry_quantized_init(&telemetry_history, format);
+    telemetry_history_running = true;
+}
+
+/* Rule 5: Mean over the whole history (per-block SIMD decode + reduction) and the
+ * largest quantization error it carries */
+Status get_history_mean(double *mean, size_t *count, double *max_error) {
+    assert(mean != NULL && count != NULL && max_error != NULL);  // Rule 7
+    assert(telemetry_history_running);
+    poll_telemetry_logging();
+    
+    *count = telemetry_quantized_count(&telemetry_history);
+    if (*count == 0) {
+        return STATUS_INVALID_DATA;
+    }
+    *mean = telemetry_quantized_sum(&telemetry_history) / (double)*count;
+    *max_error = telemetry_quantized_max_error(&telemetry_history);
+    return STATUS_OK;
+}
+
+// ============================================
+// CRASH-CONSISTENT JOURNAL: window -> mapped file
+// ============================================
+
+static TelemetryData recovery_scratch[64];
+
+/* Rule 5: Call at startup, before the first sample. Maps path (created
+ * if missing); samples a previous run left there are put back in the
+ * window and the per-sensor stats and counted in *recovered. From then on
+ * every buffered sample is journaled in place. */
+Status start_telemetry_persistence(const char *path, size_t *recovered) {
+    assert(path != NULL && recovered != NULL && !telemetry_persist_running);  // Rule 7
+    
+    if (!telemetry_persist_open(&telemetry_persist, path, recovered)) {  // Rule 5
+        return STATUS_FILE_ERROR;
+    }
+    
+    // Read in place from the mapping, oldest first: nothing to parse.
+    // Rule 2: Bounded - the journal holds TELEMETRY_PERSIST_CAPACITY
+    uint64_t cursor = telemetry_persist_oldest(&telemetry_persist);
+    for (size_t round = 0; round <= TELEMETRY_PERSIST_CAPACITY / 64; round++) {
+        size_t n = telemetry_persist_read(&telemetry_persist, &cursor, recovery_scratch, 64);
+        for (size_t i = 0; i < n; i++) {
+            buffer_telemetry_sample(&recovery_scratch[i]);  // Not journaled again yet
+        }
+        (void)sensor_stats_update_batch(&sensor_stats, recovery_scratch, n);
+        if (n < 64) {
+            break;
+        }
+    }
+    
+    telemetry_persist_running = true;
+    return STATUS_OK;
+}
+
+/* Rule 5: Durable point - everything buffered so far survives power loss */
+Status commit_telemetry(void) {
+    assert(telemetry_persist_running);  // Rule 7
+    
+    return telemetry_persist_commit(&telemetry_persist, true) ? STATUS_OK : STATUS_FILE_ERROR;
+}
+
+/* Rule 5: Durable commit and unmap */
+Status stop_telemetry_persistence(void) {
+    assert(telemetry_persist_running);  // Rule 7
+    
+    telemetry_persist_running = false;
+    return telemetry_persist_close(&telemetry_persist) ? STATUS_OK : STATUS_FILE_ERROR;
+}
+
+// ============================================
+// CONCURRENT INGEST: acquisition threads -> ring -> window
+// ============================================
+
+/* Rule 3: Shared ring (~64 KiB) and the consumer's cursor, static. The
+ * ring lives in process memory, or in shared memory once published. */
+static TelemetryRing private_ring;
+static TelemetryRing *telemetry_ring = &private_ring;
+static TelemetryShmPublisher telemetry_publisher;
+static bool telemetry_published = false;
+static bool telemetry_ring_ready = false;
+static uint64_t ingest_cursor = 0;
+static TelemetryData drain_scratch[64];
+
+/* Producers run on any thread: a stateless source, never the owner's
+ * CACHED one (its refresh is not shared across threads) */
+static ClockSource ingest_clock;
+
+static Status start_ingest_clock(void) {
+    ingest_cursor = 0;
+    telemetry_ring_ready = true;
+    if (!telemetry_clock_ready) {
+        (void)select_telemetry_clock(TELEMETRY_CLOCK_DEFAULT);  // Calibrates the TSC
+    }
+    return clock_source_init(&ingest_clock, CLOCK_SOURCE_TSC) ? STATUS_OK : STATUS_INVALID_DATA;
+}
+
+/* Rule 5: Call once from the startup thread, before any producer runs */
+Status start_telemetry_ingest(void) {
+    assert(!telemetry_published);  // Rule 7: stop_telemetry_publication first
+    
+    telemetry_ring_init(&private_ring);
+    telemetry_ring = &private_ring;
+    return start_ingest_clock();
+}
+
+/* Rule 5: Like start_telemetry_ingest(), but the ring is created in the
+ * POSIX shared-memory segment name, so other processes can map it
+ * read-only (telemetry_shm_open) and follow ingest live. */
+Status start_telemetry_publication(const char *name) {
+    assert(name != NULL && !telemetry_published);  // Rule 7
+    
+    if (!telemetry_shm_create(&telemetry_publisher, name)) {  // Rule 5
+        return STATUS_FILE_ERROR;
+    }
+    telemetry_ring = telemetry_shm_ring(&telemetry_publisher);
+    telemetry_published = true;
+    return start_ingest_clock();
+}
+
+/* Rule 5: Call after the producers stopped; removes the segment name */
+void stop_telemetry_publication(void) {
+    assert(telemetry_published);  // Rule 7
+    
+    telemetry_shm_close(&telemetry_publisher, true);
+    telemetry_published = false;
+    telemetry_ring_ready = false;
+    telemetry_ring = &private_ring;
+}
+
+/* Rule 4: Thread-safe - any number of acquisition threads. Does not touch
+ * telemetry_buffer; drain_telemetry_ingest() moves samples there. */
+Status ingest_telemetry_sample(int sensor_id, double temperature) {
+    assert(telemetry_ring_ready);  // Rule 7
+    assert(sensor_id >= 0);
+    
+    if (!isfinite(temperature)) {
+        return STATUS_INVALID_DATA;
+    }
+    
+    uint64_t now_ns = clock_source_now(&ingest_clock);
+    TelemetryData sample = {
+        .sensor_id = sensor_id,
+        .temperature = temperature,
+        .timestamp = clock_source_unix_seconds(now_ns),
+        .valid = true,
+        .time_ns = now_ns
+    };
+    
+    // Rule 5: A stalled writer in the slot drops the sample (counted)
+    return telemetry_ring_publish(telemetry_ring, &sample) ? STATUS_OK : STATUS_INVALID_DATA;
+}
+
+/* Rule 4: Consumer thread only - fold newly published samples into the
+ * window in ticket order. *lost counts samples overwritten before this
+ * call could read them. */
+Status drain_telemetry_ingest(uint64_t *lost) {
+    assert(telemetry_ring_ready && lost != NULL);  // Rule 7
+    poll_telemetry_logging();
+    
+    *lost = 0;
+    
+    // Rule 2: Bounded - the ring holds at most TELEMETRY_RING_CAPACITY
+    for (size_t round = 0; round <= TELEMETRY_RING_CAPACITY / 64; round++) {
+        size_t n = telemetry_ring_read(telemetry_ring, &ingest_cursor,
+                                       drain_scratch, 64, lost);
+        for (size_t i = 0; i < n; i++) {
+            buffer_telemetry_sample(&drain_scratch[i]);
+        }
+        if (sensor_stats_update_batch(&sensor_stats, drain_scratch, n) != n) {
+            return STATUS_INVALID_DATA;  // Rule 5: Too many distinct sensors
+        }
+        if (n < 64) {
+            break;
+        }
+    }
     
     return STATUS_OK;
 }
 
-/* Rule 4: Small, focused function */
-void recalculate_average(void) {
+/* Rule 4: Thread-safe - the newest k ingested samples, oldest first */
+size_t get_latest_telemetry(TelemetryData *out, size_t k) {
+    assert(telemetry_ring_ready && out != NULL);  // Rule 7
+    
+    return telemetry_ring_snapshot(telemetry_ring, out, k);
+}
+
+/* Rule 4: Small functions - all O(1) */
+double get_average_temperature(void) {
+    return telemetry_window_mean(&telemetry_buffer.stats);
+}
+
+double get_temperature_variance(void) {
+    return telemetry_window_variance(&telemetry_buffer.stats);
+}
+
+double get_min_temperature(void) {
+    return telemetry_window_min(&telemetry_buffer.stats);
+}
+
+double get_max_temperature(void) {
+    return telemetry_window_max(&telemetry_buffer.stats);
+}
+
+/* Rule 3: Static scratch so the sample buffer keeps its order */
+static double percentile_scratch[MAX_TELEMETRY_SAMPLES];
+
+/* Rule 4: Small function - p50/p90/p99 without a full sort */
+Status get_temperature_percentiles(const double *ps, size_t k, double *out) {
+    assert(ps != NULL && out != NULL);  // Rule 7
+    
     if (telemetry_buffer.count == 0) {
-        telemetry_buffer.running_average = 0.0;
-        return;
+        return STATUS_INVALID_DATA;
     }
     
-    double sum = 0.0;
-    // Rule 2: Fixed bound
     for (size_t i = 0; i < telemetry_buffer.count; i++) {
-        sum += telemetry_buffer.samples[i].temperature;
+        percentile_scratch[i] = telemetry_buffer.samples[i].temperature;
+    }
+    
+    if (!percentiles(percentile_scratch, telemetry_buffer.count, ps, k, out)) {
+        return STATUS_INVALID_DATA;  // Rule 5: Check return
     }
     
-    telemetry_buffer.running_average = sum / telemetry_buffer.count;
+    return STATUS_OK;
 }
 
-/* Rule 4: Small function */
-double get_average_temperature(void) {
-    return telemetry_buffer.running_average;
+/* Rule 3: Ring state and the 4 x 64 KiB registered buffers allocated
+ * statically; the ring (or its worker threads) only lives for one save
+ * or export */
+static AsyncIo telemetry_io;
+static AsyncIoStream telemetry_stream;
+
+/* Rule 4: Small function - set up the I/O ring, truncate filename */
+static bool open_telemetry_stream(const char *filename) {
+    if (!async_io_init(&telemetry_io, ASYNC_IO_BACKEND_URING)) {  // Rule 5
+        return false;
+    }
+    if (!async_io_stream_open(&telemetry_stream, &telemetry_io, filename)) {  // Rule 5
+        async_io_destroy(&telemetry_io);
+        return false;
+    }
+    return true;
 }
 
-/* Rule 5: Check all return values */
+/* Rule 4: Small function - drain and close the file, then release the
+ * ring fd and its mappings (or stop the workers) */
+static bool close_telemetry_stream(void) {
+    bool ok = async_io_stream_close(&telemetry_stream);
+    async_io_destroy(&telemetry_io);
+    return ok;
+}
+
+/* Rule 4: Small function - same bytes as fprintf("%d,%.2f,%u\n") */
+static bool stream_telemetry_lines(const TelemetryData *samples, size_t count) {
+    char line[TELEMETRY_CSV_MAX_LINE];
+    // Rule 2: Bounded by count
+    for (size_t i = 0; i < count; i++) {
+        size_t len = telemetry_csv_format_line(line, samples[i].sensor_id,
+                                               samples[i].temperature,
+                                               samples[i].timestamp);
+        if (!async_io_stream_write(&telemetry_stream, line, len)) {  // Rule 5
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Rule 5: Check all return values. One-shot dump of the current window
+ * through io_uring (thread pool where unavailable): lines are formatted
+ * into one registered buffer while the kernel writes the previous ones.
+ * This gives no throughput gain - bench_async_io measures it on par with
+ * plain write() - and sets up a ring per call; it only keeps the caller
+ * from waiting on each write. start_telemetry_logging() streams every
+ * sample without blocking. */
 Status save_telemetry_to_file(const char *filename) {
     assert(filename != NULL);  // Rule 7
     
-    FILE *file = fopen(filename, "w");
-    if (file == NULL) {  // Rule 5: Check return
+    if (!open_telemetry_stream(filename)) {  // Rule 5
         return STATUS_FILE_ERROR;
     }
     
-    // Rule 2: Fixed bound
+    // The window ring as at most two contiguous runs, oldest first
+    size_t oldest = (telemetry_buffer.head + MAX_TELEMETRY_SAMPLES
+                     - telemetry_buffer.count) % MAX_TELEMETRY_SAMPLES;
+    size_t first_run = MAX_TELEMETRY_SAMPLES - oldest;
+    if (first_run > telemetry_buffer.count) {
+        first_run = telemetry_buffer.count;
+    }
+    if (!stream_telemetry_lines(&telemetry_buffer.samples[oldest], first_run) ||
+        !stream_telemetry_lines(telemetry_buffer.samples,
+                                telemetry_buffer.count - first_run)) {  // Rule 5
+        (void)close_telemetry_stream();
+        return STATUS_FILE_ERROR;
+    }
+    
+    if (!close_telemetry_stream()) {  // Rule 5: Drain + close
+        return STATUS_FILE_ERROR;
+    }
+    
+    return STATUS_OK;
+}
+
+/* Rule 3: Encoder state (~25 KiB) allocated statically */
+static TelemetryEncoder block_encoder;
+
+/* Rule 4: Small function - window as one compressed columnar block */
+size_t encode_telemetry_block(uint8_t *out, size_t capacity) {
+    assert(out != NULL);  // Rule 7
+    
+    telemetry_encoder_reset(&block_encoder);
+    
+    // Rule 2: Fixed bound (MAX_TELEMETRY_SAMPLES < TELEMETRY_BLOCK_SAMPLES)
     for (size_t i = 0; i < telemetry_buffer.count; i++) {
-        TelemetryData *sample = &telemetry_buffer.samples[i];
-        
-        int result = fprintf(file, "%d,%.2f,%u\n",
-                            sample->sensor_id,
-                            sample->temperature,
-                            sample->timestamp);
-        
-        if (result < 0) {  // Rule 5: Check fprintf
-            fclose(file);
+        if (!telemetry_encoder_add(&block_encoder, telemetry_sample_at(i))) {
+            return 0;  // Rule 5: Dictionary full
+        }
+    }
+    
+    return telemetry_encoder_finish(&block_encoder, out, capacity);
+}
+
+/* Rule 3: Archive writer (encoder + block scratch) allocated statically.
+ * It stays open between archive_telemetry() calls, so every sealed slot
+ * holds a full block however often the window is archived. */
+static TelemetryArchiveWriter archive_writer;
+static bool archive_writer_open = false;
+
+/* High-water mark: telemetry_buffer.total after the last sample appended
+ * to the archive at archived_path */
+static char archived_path[TELEMETRY_ARCHIVE_MAX_PATH];
+static uint64_t archived_total;
+
+/* Rule 5: Seal the pending block and close the archive. Samples appended
+ * since the last full block only reach the file (and its readers) here. */
+Status close_telemetry_archive(void) {
+    if (!archive_writer_open) {
+        return STATUS_OK;
+    }
+    archive_writer_open = false;
+    return telemetry_archive_writer_close(&archive_writer) ? STATUS_OK : STATUS_FILE_ERROR;
+}
+
+/* Rule 4: Small function - make path the open archive; another file
+ * closes the current one and starts from the whole window */
+static bool select_telemetry_archive(const char *path) {
+    bool same_path = (strncmp(archived_path, path, sizeof(archived_path)) == 0);
+    if (archive_writer_open && same_path) {
+        return true;
+    }
+    if (close_telemetry_archive() != STATUS_OK) {  // Rule 5
+        return false;
+    }
+    if (!same_path) {
+        archived_total = telemetry_buffer.total - telemetry_buffer.count;
+    }
+    if (!telemetry_archive_writer_open(&archive_writer, path)) {  // Rule 5
+        return false;
+    }
+    snprintf(archived_path, sizeof(archived_path), "%s", path);
+    archive_writer_open = true;
+    return true;
+}
+
+/* Rule 5: Append the window samples not yet archived to path. Samples
+ * evicted from the window before the call never reach the archive; the
+ * last partial block waits for close_telemetry_archive(). */
+Status archive_telemetry(const char *path) {
+    assert(path != NULL);  // Rule 7
+    
+    if (!select_telemetry_archive(path)) {
+        return STATUS_FILE_ERROR;
+    }
+    uint64_t pending = telemetry_buffer.total - archived_total;
+    if (pending > telemetry_buffer.count) {
+        pending = telemetry_buffer.count;  // Overwritten before this call
+    }
+    
+    // Rule 2: Fixed bound, oldest first keeps timestamps ordered
+    for (size_t i = telemetry_buffer.count - (size_t)pending; i < telemetry_buffer.count; i++) {
+        if (!telemetry_archive_append(&archive_writer, telemetry_sample_at(i))) {
+            (void)close_telemetry_archive();  // The unsealed block is lost
             return STATUS_FILE_ERROR;
         }
+        archived_total = telemetry_buffer.total - telemetry_buffer.count + i + 1;
+    }
+    
+    return STATUS_OK;
+}
+
+/* Rule 4: Copy archived samples with from <= timestamp <= to into out.
+ * Only the blocks overlapping the range are decoded; an archive still
+ * open for archive_telemetry() shows its sealed blocks only. */
+Status read_telemetry_range(const char *path, uint32_t from, uint32_t to,
+                            TelemetryData *out, size_t capacity, size_t *found) {
+    assert(path != NULL && out != NULL && found != NULL);  // Rule 7
+    
+    static TelemetryArchiveQuery query;  // Rule 3: Decoder state is ~5 KiB
+    TelemetryArchive archive;
+    *found = 0;
+    
+    if (!telemetry_archive_open(&archive, path)) {
+        return STATUS_FILE_ERROR;
     }
     
-    if (fclose(file) != 0) {  // Rule 5: Check fclose
+    telemetry_archive_query(&query, &archive, from, to);
+    
+    // Rule 2: Bounded by capacity
+    while (*found < capacity && telemetry_archive_query_next(&query, &out[*found])) {
+        (*found)++;
+    }
+    
+    bool corrupt = query.corrupt;
+    telemetry_archive_close(&archive);
+    
+    return corrupt ? STATUS_INVALID_DATA : STATUS_OK;
+}
+
+// ============================================
+// DOWNSAMPLED EXPORT: ring or archive -> plot points
+// ============================================
+
+#define MAX_EXPORT_SAMPLES (1ull << 32)  // Rule 2: Bound of one archive scan
+
+static TelemetryDownsampler export_downsampler;
+static int export_sensor_id;  // The one series being reduced
+static TelemetryArchiveQuery export_query;  // Rule 3: Decoder state is ~5 KiB
+static TelemetryData export_scratch[64];
+
+/* Rule 4: Small function - feed one sample of the exported sensor,
+ * write the points it completes */
+static bool downsample_to_stream(const TelemetryData *sample) {
+    if (sample->sensor_id != export_sensor_id) {
+        return true;  // Other sensors would interleave into one series
+    }
+    TelemetryData points[TELEMETRY_DOWNSAMPLE_MAX_EMIT];
+    size_t n = telemetry_downsample_push(&export_downsampler, sample, points);
+    return stream_telemetry_lines(points, n);
+}
+
+/* Rule 5: One pass over the archived blocks of the range */
+static Status downsample_archive(const char *path) {
+    TelemetryArchive archive;
+    if (!telemetry_archive_open(&archive, path)) {
         return STATUS_FILE_ERROR;
     }
+    telemetry_archive_query(&export_query, &archive, export_downsampler.from,
+                            export_downsampler.to);
     
+    Status status = STATUS_OK;
+    TelemetryData sample;
+    // Rule 2: Bounded scan
+    for (uint64_t i = 0; i < MAX_EXPORT_SAMPLES &&
+                         telemetry_archive_query_next(&export_query, &sample); i++) {
+        if (!downsample_to_stream(&sample)) {
+            status = STATUS_FILE_ERROR;
+            break;
+        }
+    }
+    if (status == STATUS_OK && export_query.corrupt) {
+        status = STATUS_INVALID_DATA;
+    }
+    telemetry_archive_close(&archive);
+    return status;
+}
+
+/* Rule 5: One pass over what the ingest ring still holds, oldest first */
+static Status downsample_ring(void) {
+    uint64_t published = telemetry_ring_published(telemetry_ring);
+    uint64_t cursor = (published > TELEMETRY_RING_CAPACITY) ?
+                      published - TELEMETRY_RING_CAPACITY : 0;
+    uint64_t lost = 0;
+    
+    // Rule 2: Bounded - the ring holds at most TELEMETRY_RING_CAPACITY
+    for (size_t round = 0; round <= TELEMETRY_RING_CAPACITY / 64; round++) {
+        size_t n = telemetry_ring_read(telemetry_ring, &cursor, export_scratch, 64, &lost);
+        for (size_t i = 0; i < n; i++) {
+            if (!downsample_to_stream(&export_scratch[i])) {
+                return STATUS_FILE_ERROR;
+            }
+        }
+        if (n < 64) {
+            break;
+        }
+    }
     return STATUS_OK;
 }
 
+/* Rule 5: Write about `points` samples of sensor_id in [from, to) (Unix
+ * seconds) as CSV: LTTB keeps the shape, MINMAX every spike. Reads the
+ * archive at archive_path, or the ingest ring when archive_path is NULL,
+ * in one pass and constant memory; one call per sensor to plot. */
+Status export_telemetry_downsampled(const char *filename, const char *archive_path,
+                                    int sensor_id, uint32_t from, uint32_t to,
+                                    size_t points, TelemetryDownsampleMode mode) {
+    assert(filename != NULL && from < to && points >= 4);  // Rule 7
+    assert(archive_path != NULL || telemetry_ring_ready);
+    
+    export_sensor_id = sensor_id;
+    size_t buckets = (mode == TELEMETRY_DOWNSAMPLE_LTTB) ? points - 2 : points / 2;
+    telemetry_downsample_init(&export_downsampler, mode, from, to, buckets);
+    if (!open_telemetry_stream(filename)) {  // Rule 5
+        return STATUS_FILE_ERROR;
+    }
+    
+    Status status = (archive_path != NULL) ? downsample_archive(archive_path)
+                                           : downsample_ring();
+    TelemetryData tail[TELEMETRY_DOWNSAMPLE_MAX_EMIT];
+    size_t n = telemetry_downsample_finish(&export_downsampler, tail);
+    if (status == STATUS_OK && !stream_telemetry_lines(tail, n)) {
+        status = STATUS_FILE_ERROR;
+    }
+    if (!close_telemetry_stream() && status == STATUS_OK) {  // Rule 5
+        status = STATUS_FILE_ERROR;
+    }
+    return status;
+}
+
 // ============================================
 // MAIN - Demonstration
 // ============================================
@@ -612,14 +1279,21 @@ int main(void) {
     printf("Rule 3 - Static Allocation:\n");
     GoodBuffer buffer;
     good_init_buffer(&buffer);
-    printf("  Buffer initialized (statically allocated)\n\n");
+    printf("  Buffer initialized (statically allocated)\n");
+    bool added = sensor_pool_add(101, 7) && sensor_pool_add(205, 9) && sensor_pool_add(309, 3);
+    assert(added);  // Rule 7
+    (void)sensor_pool_remove(205);  // Swap-remove keeps the pool dense
+    const Sensor *sensor = sensor_pool_find(309);
+    printf("  Sensor pool: %zu live, sensor 309 = %d\n\n",
+           sensor_pool.count, (sensor != NULL) ? sensor->value : -1);
     
     // Test Rule 4: Small functions
     printf("Rule 4 - Small Functions:\n");
     int data[] = {5, 2, 8, 1, 9};
     sort_array(data, 5);
     int mean = calculate_mean(data, 5);
-    printf("  Mean of sorted array: %d\n\n", mean);
+    printf("  Mean of sorted array: %d\n", mean);
+    printf("  Median: %d\n\n", find_median(data, 5));
     
     // Test Rule 5: Check returns
     printf("Rule 5 - Check Return Values:\n");
@@ -634,6 +1308,7 @@ int main(void) {
     
     // Test complete system
     printf("Complete System Test - Telemetry:\n");
+    start_telemetry_history(TELEMETRY_QUANTIZED_INT16);
     status = add_telemetry_sample(1, 25.5);
     assert(status == STATUS_OK);  // Rule 7
     
@@ -645,7 +1320,100 @@ int main(void) {
     
     double avg = get_average_temperature();
     printf("  Average temperature: %.2f°C\n", avg);
-    printf("  Samples collected: %zu\n\n", telemetry_buffer.count);
+    printf("  Min/Max: %.2f / %.2f°C, variance: %.4f\n",
+           get_min_temperature(), get_max_temperature(),
+           get_temperature_variance());
+    printf("  Samples collected: %zu\n", telemetry_buffer.count);
+    
+    const double ps[] = {50.0, 90.0, 99.0};
+    double pct[3];
+    status = get_temperature_percentiles(ps, 3, pct);
+    assert(status == STATUS_OK);
+    printf("  p50/p90/p99: %.2f / %.2f / %.2f°C\n", pct[0], pct[1], pct[2]);
+    
+    static uint8_t block[TELEMETRY_BLOCK_MAX_BYTES];  // Rule 3
+    size_t block_size = encode_telemetry_block(block, sizeof(block));
+    assert(block_size > 0);  // Rule 7
+    printf("  Compressed block: %zu bytes for %zu samples\n",
+           block_size, telemetry_buffer.count);
+    
+    const double ingested[] = {21.5, -300.0, 22.0, 1500.0, 23.25};
+    uint64_t valid_bitmap[TELEMETRY_BITMAP_WORDS(5)];
+    double valid_temps[5];
+    size_t valid = process_telemetry_batch(ingested, 5, valid_bitmap);
+    size_t kept = telemetry_compact_valid(ingested, 5, valid_bitmap, valid_temps);
+    assert(kept == valid);  // Rule 7
+    printf("  Batch validation: %zu/5 valid (bitmap 0x%llx)\n",
+           kept, (unsigned long long)valid_bitmap[0]);
+    
+    // Acquisition threads would call ingest_telemetry_sample concurrently;
+    // publishing the ring lets external readers follow (private if no shm)
+    status = start_telemetry_publication(TELEMETRY_SHM_DEFAULT_NAME);
+    bool published = (status != STATUS_FILE_ERROR);
+    if (!published) {
+        status = start_telemetry_ingest();
+    }
+    assert(status == STATUS_OK || status == STATUS_INVALID_DATA);
+    for (int reading = 0; reading < 3; reading++) {
+        status = ingest_telemetry_sample(2, 24.0 + reading);
+        assert(status == STATUS_OK);
+    }
+    TelemetryData latest[2];
+    size_t latest_count = get_latest_telemetry(latest, 2);
+    uint64_t lost = 0;
+    status = drain_telemetry_ingest(&lost);
+    assert(status == STATUS_OK);
+    printf("  Concurrent ingest: latest %zu = %.1f, %.1f°C; window now %zu samples, %llu lost\n",
+           latest_count, latest[0].temperature, latest[1].temperature,
+           telemetry_buffer.count, (unsigned long long)lost);
+    if (published) {
+        // What telemetry_shm_reader does from another process
+        TelemetryShmReader reader;
+        if (telemetry_shm_open(&reader, TELEMETRY_SHM_DEFAULT_NAME)) {  // Rule 5
+            TelemetryData shared[4];
+            uint64_t shared_lost = 0;
+            size_t seen = telemetry_shm_read(&reader, shared, 4, &shared_lost);
+            printf("  Shared memory %s: reader mapped %zu samples\n",
+                   TELEMETRY_SHM_DEFAULT_NAME, seen);
+            telemetry_shm_reader_close(&reader);
+        }
+        stop_telemetry_publication();
+    }
+    
+    // Rule 6: Declared where used
+    for (int sensor_id = 1; sensor_id <= 2; sensor_id++) {
+        SensorGroupStats group;
+        if (get_sensor_stats(sensor_id, &group) == STATUS_OK) {  // Rule 5
+            printf("  Sensor %d: %llu samples, mean %.2f°C, range %.2f - %.2f°C\n",
+                   sensor_id, (unsigned long long)group.count, group.mean,
+                   group.min, group.max);
+        }
+    }
+    
+    // A slow drift from a third sensor fills a few quantized blocks
+    for (int reading = 0; reading < 1000; reading++) {
+        status = add_telemetry_sample(3, 20.0 + (double)(reading % 100) * 0.01);
+        assert(status == STATUS_OK);
+    }
+    double history_mean = 0.0;
+    double history_error = 0.0;
+    size_t history_count = 0;
+    if (get_history_mean(&history_mean, &history_count, &history_error) == STATUS_OK) {
+        printf("  History: %zu samples, mean %.3f°C, quantization error <= %.1e°C "
+               "(%zu KiB for %d samples)\n",
+               history_count, history_mean, history_error,
+               sizeof(TelemetryQuantized) / 1024,
+               TELEMETRY_QUANTIZED_BLOCKS * TELEMETRY_QUANTIZED_BLOCK);
+    }
+    uint32_t now = clock_source_unix_seconds(clock_source_now(&telemetry_clock));
+    TelemetryRollupSummary last_hour;
+    // The 3600 s ending now: whole minutes, edge seconds, all still held
+    if (get_telemetry_summary(now - 3599, now + 1, &last_hour) == STATUS_OK) {  // Rule 5
+        printf("  Last hour: %llu samples, mean %.3f°C, range %.2f - %.2f°C (%s)\n",
+               (unsigned long long)last_hour.count, last_hour.sum / (double)last_hour.count,
+               last_hour.min, last_hour.max, last_hour.exact ? "exact" : "widened");
+    }
+    printf("\n");
     
     printf("✅ All rules demonstrated successfully!\n");
     printf("\nCompile with: gcc -Wall -Wextra -Werror -pedantic -std=c11 nasa_rules.c\n");
@@ -0,0 +1,49 @@
+/*
+ * RULE 1 COMMAND HASH - Hash shared by the command table generator and
+ * the parser
+ *
+ * 8 bytes per round (assembled little-endian, so generated tables do not
+ * depend on the host), a multiply-xorshift per word and a final mix.
+ * command_slot() places a key of bucket b with that bucket's
+ * displacement: the mix after the XOR makes each displacement scatter
+ * the bucket's keys independently, which is what the generator's
+ * search relies on.
+ */
+
+#ifndef RULE01_COMMAND_HASH_H
+#define RULE01_COMMAND_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+static inline uint64_t command_mix(uint64_t x) {
+    x ^= x >> 31;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 29;
+    x *= 0x94D049BB133111EBull;
+    return x ^ (x >> 32);
+}
+
+static inline uint64_t command_hash(const char *name, size_t length, uint64_t seed) {
+    uint64_t hash = seed ^ ((uint64_t)length * 0x9E3779B97F4A7C15ull);
+    for (size_t i = 0; i < length; i += 8) {
+        uint64_t word = 0;
+        size_t take = (length - i < 8) ? length - i : 8;
+        for (size_t j = 0; j < take; j++) {
+            word |= (uint64_t)(unsigned char)name[i + j] << (8 * j);
+        }
+        hash = command_mix(hash ^ word);
+    }
+    return hash;
+}
+
+static inline uint32_t command_bucket(uint64_t hash, uint32_t buckets) {
+    return (uint32_t)(hash >> 32) % buckets;
+}
+
+/* slots is a power of two */
+static inline uint32_t command_slot(uint64_t hash, uint32_t displacement, uint32_t slots) {
+    return (uint32_t)command_mix(hash ^ displacement) & (slots - 1);
+}
+
+#endif /* RULE01_COMMAND_HASH_H */
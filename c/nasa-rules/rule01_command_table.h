@@ -0,0 +1,26 @@
+/*
+ * RULE 1 COMMAND TABLE - Generated by tools/gen_command_table.c from
+ * rule01_commands.def. Do not edit: run make.
+ */
+
+#ifndef RULE01_COMMAND_TABLE_H
+#define RULE01_COMMAND_TABLE_H
+
+#include <stdint.h>
+
+#define COMMAND_HASH_SEED 0x434D445441424C45ull
+#define COMMAND_BUCKETS 2u
+#define COMMAND_SLOTS 8u
+#define COMMAND_NAME_MAX 10
+
+/* Displacement of each bucket */
+static const uint16_t COMMAND_DISPLACEMENT[COMMAND_BUCKETS] = {
+    3, 6
+};
+
+/* Command index + 1 in each slot, 0 = empty */
+static const uint16_t COMMAND_SLOT_ENTRY[COMMAND_SLOTS] = {
+    0, 0, 1, 4, 6, 2, 3, 5
+};
+
+#endif /* RULE01_COMMAND_TABLE_H */
@@ -4,12 +4,19 @@
  * No goto, setjmp/longjmp, or indirect recursion
  * Keep control flow simple and predictable
  * 
- * Compilation: gcc -Wall -Wextra -Werror -std=c11 rule01_control_flow.c
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -I../common rule01_control_flow.c ../common/checksum.c ../common/state_machine.c ../common/cpu_features.c -pthread
  */
 
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "checksum.h"
+#include "state_machine.h"
+#include "rule01_command_hash.h"
+#include "rule01_command_table.h"  /* Generated from rule01_commands.def */
 
 // ============================================
 // ❌ BAD EXAMPLES - What NOT to do
@@ -223,126 +230,529 @@ ErrorCode good_validate_and_process(const int *data, size_t size, int *output) {
 // REAL-WORLD EXAMPLES
 // ============================================
 
-/* Example: Command parser with structured flow */
+/* Example: Command dispatch generated from one declarative list.
+ * rule01_commands.def names every verb, its handler and its argument
+ * count; tools/gen_command_table.c turns the names into a perfect hash
+ * (rule01_command_table.h). Parsing is one hash, one table probe and one
+ * memcmp however many verbs the protocol has; executing is one indexed
+ * call through a const jump table. The table lists every handler, so the
+ * call graph stays known to static analysis. */
 typedef enum {
-    CMD_START,
-    CMD_STOP,
-    CMD_RESET,
-    CMD_STATUS,
-    CMD_UNKNOWN
+#define COMMAND(name, id, handler, arg_count) id,
+#include "rule01_commands.def"
+#undef COMMAND
+    CMD_UNKNOWN,
+    CMD_COUNT = CMD_UNKNOWN
 } Command;
 
+#define COMMAND_ARGS_MAX 4
+
+typedef struct {
+    int32_t values[COMMAND_ARGS_MAX];
+    size_t count;
+} CommandArgs;
+
+typedef bool (*CommandHandler)(const CommandArgs *args);
+
+typedef struct {
+    const char *name;
+    uint8_t length;
+    uint8_t arg_count;
+} CommandInfo;
+
+static const CommandInfo COMMAND_INFO[CMD_COUNT] = {
+#define COMMAND(name, id, handler, arg_count) {#name, sizeof(#name) - 1, arg_count},
+#include "rule01_commands.def"
+#undef COMMAND
+};
+
+static bool cmd_start(const CommandArgs *args) {
+    (void)args;
+    printf("System starting...\n");
+    return true;
+}
+
+static bool cmd_stop(const CommandArgs *args) {
+    (void)args;
+    printf("System stopping...\n");
+    return true;
+}
+
+static bool cmd_reset(const CommandArgs *args) {
+    (void)args;
+    printf("System resetting...\n");
+    return true;
+}
+
+static bool cmd_status(const CommandArgs *args) {
+    (void)args;
+    printf("System status: OK\n");
+    return true;
+}
+
+static bool cmd_set_rate(const CommandArgs *args) {
+    if (args->values[0] <= 0) {
+        printf("Invalid rate\n");
+        return false;
+    }
+    printf("Sample rate: %d Hz\n", (int)args->values[0]);
+    return true;
+}
+
+static bool cmd_set_limits(const CommandArgs *args) {
+    if (args->values[0] >= args->values[1]) {
+        printf("Invalid limits\n");
+        return false;
+    }
+    printf("Limits: %d .. %d\n", (int)args->values[0], (int)args->values[1]);
+    return true;
+}
+
+static const CommandHandler COMMAND_HANDLERS[CMD_COUNT] = {
+#define COMMAND(name, id, handler, arg_count) handler,
+#include "rule01_commands.def"
+#undef COMMAND
+};
+
+/* Length of the verb at the start of text, bounded by COMMAND_NAME_MAX + 1 */
+static size_t verb_length(const char *text) {
+    size_t length = 0;
+    while (length <= COMMAND_NAME_MAX && text[length] != '\0' && text[length] != ' ') {
+        length++;
+    }
+    return length;
+}
+
+/* GOOD: One hash, one probe, one memcmp - no chain of comparisons */
+static Command lookup_command(const char *verb, size_t length) {
+    if (length == 0 || length > COMMAND_NAME_MAX) {
+        return CMD_UNKNOWN;
+    }
+    uint64_t hash = command_hash(verb, length, COMMAND_HASH_SEED);
+    uint32_t bucket = command_bucket(hash, COMMAND_BUCKETS);
+    uint32_t slot = command_slot(hash, COMMAND_DISPLACEMENT[bucket], COMMAND_SLOTS);
+    uint16_t entry = COMMAND_SLOT_ENTRY[slot];
+    if (entry == 0) {
+        return CMD_UNKNOWN;
+    }
+    const CommandInfo *info = &COMMAND_INFO[entry - 1];
+    if (info->length != length || memcmp(info->name, verb, length) != 0) {
+        return CMD_UNKNOWN;
+    }
+    return (Command)(entry - 1);
+}
+
+/* The verb of cmd_string (up to the first space) */
 Command parse_command(const char *cmd_string) {
     if (cmd_string == NULL) {
         return CMD_UNKNOWN;
     }
-    
-    // Simple string comparison (in real code, use strncmp)
-    if (cmd_string[0] == 'S' && cmd_string[1] == 'T' && cmd_string[2] == 'A') {
-        if (cmd_string[3] == 'R' && cmd_string[4] == 'T') {
-            return CMD_START;
+    return lookup_command(cmd_string, verb_length(cmd_string));
+}
+
+/* Space-separated integer arguments; false if malformed or too many */
+static bool parse_arguments(const char *text, CommandArgs *args) {
+    args->count = 0;
+    // Rule 2: At most COMMAND_ARGS_MAX + 1 rounds
+    for (size_t round = 0; round <= COMMAND_ARGS_MAX; round++) {
+        if (*text == '\0') {
+            return true;
         }
-        if (cmd_string[3] == 'T' && cmd_string[4] == 'U') {
-            return CMD_STATUS;
+        if (*text != ' ' || args->count == COMMAND_ARGS_MAX) {
+            return false;
+        }
+        char *end = NULL;
+        long value = strtol(text + 1, &end, 10);
+        if (end == text + 1 || value < INT32_MIN || value > INT32_MAX) {
+            return false;
         }
+        args->values[args->count++] = (int32_t)value;
+        text = end;
     }
-    
-    if (cmd_string[0] == 'S' && cmd_string[1] == 'T' && cmd_string[2] == 'O') {
-        return CMD_STOP;
+    return *text == '\0';
+}
+
+static bool dispatch_command(Command cmd, const CommandArgs *args) {
+    if (cmd >= CMD_COUNT) {
+        printf("Unknown command\n");
+        return false;
     }
-    
-    if (cmd_string[0] == 'R' && cmd_string[1] == 'E' && cmd_string[2] == 'S') {
-        return CMD_RESET;
+    if (args->count != COMMAND_INFO[cmd].arg_count) {
+        printf("%s takes %u argument(s)\n", COMMAND_INFO[cmd].name,
+               (unsigned)COMMAND_INFO[cmd].arg_count);
+        return false;
     }
-    
-    return CMD_UNKNOWN;
+    return COMMAND_HANDLERS[cmd](args);
 }
 
+/* A command without arguments */
 bool execute_command(Command cmd) {
-    switch (cmd) {
-        case CMD_START:
-            printf("System starting...\n");
-            return true;
-            
-        case CMD_STOP:
-            printf("System stopping...\n");
-            return true;
-            
-        case CMD_RESET:
-            printf("System resetting...\n");
-            return true;
-            
-        case CMD_STATUS:
-            printf("System status: OK\n");
+    const CommandArgs none = {.count = 0};
+    return dispatch_command(cmd, &none);
+}
+
+/* A whole line: "SET_LIMITS -20 85" */
+bool execute_command_line(const char *line) {
+    if (line == NULL) {
+        return false;
+    }
+    size_t length = verb_length(line);
+    CommandArgs args;
+    if (!parse_arguments(line + length, &args)) {
+        printf("Malformed arguments\n");
+        return false;
+    }
+    return dispatch_command(lookup_command(line, length), &args);
+}
+
+/* Example: Packet processing with clear flow, in place.
+ * Frames are checked and handled where they sit in the receive buffer:
+ * a PacketView is a pointer and a length into it, never a copy. Frame
+ * layout (little-endian):
+ *
+ *   offset 0     header   0xAA
+ *          1     type
+ *          2     length   payload bytes, at most PACKET_PAYLOAD_MAX
+ *          4     payload
+ *          4+len crc      CRC32C of bytes [0, 4 + length)
+ *
+ * The CRC (hardware crc32 instruction when available) covers the header
+ * fields too: unlike a byte XOR it catches two flips in the same bit of
+ * different bytes, and any burst of up to 32 bits. */
+#define PACKET_HEADER 0xAA
+#define PACKET_PREFIX_SIZE 4
+#define PACKET_CRC_SIZE 4
+#define PACKET_OVERHEAD (PACKET_PREFIX_SIZE + PACKET_CRC_SIZE)
+#define PACKET_PAYLOAD_MAX 256
+#define PACKET_BATCH_MAX 256
+
+typedef struct {
+    const uint8_t *frame;  /* Into the receive buffer */
+    size_t size;           /* Bytes of the frame, CRC included */
+} PacketView;
+
+static inline uint8_t packet_type(const PacketView *view) {
+    return view->frame[1];
+}
+
+static inline uint16_t packet_length(const PacketView *view) {
+    return (uint16_t)(view->frame[2] | (view->frame[3] << 8));
+}
+
+static inline const uint8_t *packet_payload(const PacketView *view) {
+    return view->frame + PACKET_PREFIX_SIZE;
+}
+
+static inline uint32_t packet_crc(const PacketView *view) {
+    const uint8_t *crc = view->frame + view->size - PACKET_CRC_SIZE;
+    return (uint32_t)crc[0] | ((uint32_t)crc[1] << 8) | ((uint32_t)crc[2] << 16) |
+           ((uint32_t)crc[3] << 24);
+}
+
+/* Writes one frame at out; returns its size, 0 if it does not fit */
+size_t packet_encode(uint8_t *out, size_t capacity, uint8_t type,
+                     const uint8_t *payload, uint16_t length) {
+    size_t size = PACKET_OVERHEAD + (size_t)length;
+    if (out == NULL || length > PACKET_PAYLOAD_MAX || size > capacity) {
+        return 0;
+    }
+    out[0] = PACKET_HEADER;
+    out[1] = type;
+    out[2] = (uint8_t)(length & 0xFFu);
+    out[3] = (uint8_t)(length >> 8);
+    if (length > 0) {
+        memcpy(out + PACKET_PREFIX_SIZE, payload, length);
+    }
+    uint32_t crc = checksum_crc32c(0, out, PACKET_PREFIX_SIZE + (size_t)length);
+    for (size_t i = 0; i < PACKET_CRC_SIZE; i++) {
+        out[PACKET_PREFIX_SIZE + length + i] = (uint8_t)(crc >> (8 * i));
+    }
+    return size;
+}
+
+/* True if a frame starts at view->frame: sync byte, length in range and
+ * a matching CRC. The whole frame must be in [frame, frame + size). */
+static bool packet_frame_intact(const PacketView *view) {
+    uint16_t length = packet_length(view);
+    return view->frame[0] == PACKET_HEADER && length <= PACKET_PAYLOAD_MAX &&
+           view->size == PACKET_OVERHEAD + (size_t)length &&
+           checksum_crc32c(0, view->frame, PACKET_PREFIX_SIZE + (size_t)length) == packet_crc(view);
+}
+
+/* True if an intact frame starts somewhere in (offset, size): then the
+ * incomplete frame at offset has a corrupt length, a real one would
+ * still be covering those bytes */
+static bool packet_intact_after(const uint8_t *buffer, size_t size, size_t offset) {
+    // Rule 2: Bounded by size, one candidate per sync byte
+    for (size_t at = offset + 1; size - at >= PACKET_OVERHEAD; at++) {
+        PacketView view = {buffer + at, PACKET_OVERHEAD};
+        view.size += packet_length(&view);
+        if (buffer[at] == PACKET_HEADER && view.size <= size - at && packet_frame_intact(&view)) {
             return true;
-            
-        case CMD_UNKNOWN:
-            printf("Unknown command\n");
-            return false;
-            
-        default:
-            return false;
+        }
+    }
+    return false;
+}
+
+/* Cuts back-to-back frames of a receive buffer into views. A position
+ * that does not hold an intact frame (bad header, length or CRC) is
+ * skipped up to the next sync byte, so one corrupt frame never hides the
+ * ones behind it; *skipped counts those bytes. Stops at max_views or at
+ * an incomplete frame with no intact one after it; *consumed tells where
+ * the next read continues. */
+size_t packet_split(const uint8_t *buffer, size_t size, PacketView *views,
+                    size_t max_views, size_t *consumed, size_t *skipped) {
+    size_t count = 0;
+    size_t offset = 0;
+    size_t dropped = 0;
+    // Rule 2: At most max_views frames; every other pass advances offset
+    while (count < max_views && size - offset >= PACKET_OVERHEAD) {
+        PacketView view = {buffer + offset, PACKET_OVERHEAD};
+        uint16_t length = packet_length(&view);
+        if (buffer[offset] == PACKET_HEADER && length <= PACKET_PAYLOAD_MAX) {
+            view.size += length;
+            if (view.size > size - offset) {
+                if (!packet_intact_after(buffer, size, offset)) {
+                    break;  // The rest is still on its way
+                }
+            } else if (packet_frame_intact(&view)) {
+                views[count++] = view;
+                offset += view.size;
+                continue;
+            }
+        }
+        // Resync: the next frame can only start on a sync byte
+        const uint8_t *next = memchr(buffer + offset + 1, PACKET_HEADER, size - offset - 1);
+        size_t skip = (next != NULL) ? (size_t)(next - (buffer + offset)) : size - offset;
+        dropped += skip;
+        offset += skip;
+    }
+    if (consumed != NULL) {
+        *consumed = offset;
     }
+    if (skipped != NULL) {
+        *skipped = dropped;
+    }
+    return count;
 }
 
-/* Example: Packet processing with clear flow */
+/* Where validation sends a packet: one of the handlers, or the reason it
+ * was rejected */
+typedef enum {
+    PACKET_ROUTE_DATA,      /* type 0x01 */
+    PACKET_ROUTE_CONTROL,   /* type 0x02 */
+    PACKET_ROUTE_STATUS,    /* type 0x03 */
+    PACKET_ROUTE_HANDLERS,  /* Routes below this one have a handler */
+    PACKET_REJECT_HEADER = PACKET_ROUTE_HANDLERS,
+    PACKET_REJECT_LENGTH,
+    PACKET_REJECT_CHECKSUM,
+    PACKET_REJECT_TYPE,
+    PACKET_ROUTE_COUNT
+} PacketRoute;
+
+static const char *const PACKET_REJECT_MESSAGES[PACKET_ROUTE_COUNT - PACKET_ROUTE_HANDLERS] = {
+    "Invalid header", "Invalid length", "Checksum mismatch", "Unknown packet type"};
+
+/* A handler receives the whole batch of its type at once: views[batch[i]] */
+typedef void (*PacketHandler)(const PacketView *views, const uint16_t *batch, size_t count);
+
 typedef struct {
-    uint8_t header;
-    uint8_t type;
-    uint16_t length;
-    uint8_t data[256];
-    uint8_t checksum;
-} Packet;
-
-bool process_packet(const Packet *packet) {
-    // Validation phase
-    if (packet == NULL) {
-        return false;
+    size_t counts[PACKET_ROUTE_COUNT];  /* Packets per handler and per reject reason */
+    size_t accepted;
+} PacketBatchStats;
+
+static void handle_data_packets(const PacketView *views, const uint16_t *batch, size_t count) {
+    size_t bytes = 0;
+    for (size_t i = 0; i < count; i++) {
+        bytes += packet_length(&views[batch[i]]);
     }
-    
-    if (packet->header != 0xAA) {
-        printf("Invalid header\n");
-        return false;
+    printf("Processing %zu data packet(s), %zu bytes\n", count, bytes);
+}
+
+static void handle_control_packets(const PacketView *views, const uint16_t *batch, size_t count) {
+    (void)views;
+    (void)batch;
+    printf("Processing %zu control packet(s)\n", count);
+}
+
+static void handle_status_packets(const PacketView *views, const uint16_t *batch, size_t count) {
+    (void)views;
+    (void)batch;
+    printf("Processing %zu status packet(s)\n", count);
+}
+
+static const PacketHandler PACKET_HANDLERS[PACKET_ROUTE_HANDLERS] = {
+    handle_data_packets, handle_control_packets, handle_status_packets};
+
+/* Validation in place: cheap header checks first, the CRC only for
+ * plausible frames; nothing is read outside [frame, frame + size) */
+static PacketRoute route_packet(const PacketView *view) {
+    if (view->frame == NULL || view->size < PACKET_OVERHEAD) {
+        return PACKET_REJECT_LENGTH;
     }
-    
-    if (packet->length > 256) {
-        printf("Invalid length\n");
-        return false;
+    if (view->frame[0] != PACKET_HEADER) {
+        return PACKET_REJECT_HEADER;
     }
-    
-    // Calculate checksum
-    uint8_t calculated_checksum = 0;
-    for (uint16_t i = 0; i < packet->length; i++) {
-        calculated_checksum ^= packet->data[i];
+    uint16_t length = packet_length(view);
+    if (length > PACKET_PAYLOAD_MAX || view->size != PACKET_OVERHEAD + (size_t)length) {
+        return PACKET_REJECT_LENGTH;
     }
-    
-    if (calculated_checksum != packet->checksum) {
-        printf("Checksum mismatch\n");
+    if (checksum_crc32c(0, view->frame, PACKET_PREFIX_SIZE + (size_t)length) != packet_crc(view)) {
+        return PACKET_REJECT_CHECKSUM;
+    }
+    uint8_t route = (uint8_t)(packet_type(view) - 1u);  // 0x01..0x03 -> handler index
+    return (route < PACKET_ROUTE_HANDLERS) ? (PacketRoute)route : PACKET_REJECT_TYPE;
+}
+
+/* GOOD: Three flat passes instead of a branchy path per packet.
+ * 1. validate every packet into a route byte
+ * 2. partition packet indexes by route (counting sort: stable, O(n))
+ * 3. call each handler once with its contiguous slice of indexes
+ * count <= PACKET_BATCH_MAX; adds this chunk's counts to stats. */
+static void process_packet_chunk(const PacketView *views, size_t count, PacketBatchStats *stats) {
+    uint8_t routes[PACKET_BATCH_MAX];
+    size_t counts[PACKET_ROUTE_COUNT] = {0};
+    for (size_t i = 0; i < count; i++) {
+        routes[i] = (uint8_t)route_packet(&views[i]);
+        counts[routes[i]]++;
+    }
+
+    size_t start[PACKET_ROUTE_COUNT + 1];
+    start[0] = 0;
+    for (size_t r = 0; r < PACKET_ROUTE_COUNT; r++) {
+        start[r + 1] = start[r] + counts[r];
+    }
+    uint16_t order[PACKET_BATCH_MAX];
+    size_t fill[PACKET_ROUTE_COUNT];
+    for (size_t r = 0; r < PACKET_ROUTE_COUNT; r++) {
+        fill[r] = start[r];
+    }
+    for (size_t i = 0; i < count; i++) {
+        order[fill[routes[i]]++] = (uint16_t)i;
+    }
+
+    for (size_t r = 0; r < PACKET_ROUTE_HANDLERS; r++) {
+        if (counts[r] > 0) {
+            PACKET_HANDLERS[r](views, &order[start[r]], counts[r]);
+            stats->accepted += counts[r];
+        }
+    }
+    for (size_t r = 0; r < PACKET_ROUTE_COUNT; r++) {
+        stats->counts[r] += counts[r];
+    }
+}
+
+/* Any count: chunks of PACKET_BATCH_MAX keep the scratch on the stack
+ * bounded. Returns the number of packets handled. */
+size_t process_packet_batch(const PacketView *views, size_t count, PacketBatchStats *stats) {
+    PacketBatchStats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    for (size_t r = 0; r < PACKET_ROUTE_COUNT; r++) {
+        stats->counts[r] = 0;
+    }
+    stats->accepted = 0;
+    if (views == NULL) {
+        return 0;
+    }
+
+    // Rule 2: ceil(count / PACKET_BATCH_MAX) iterations
+    for (size_t done = 0; done < count; done += PACKET_BATCH_MAX) {
+        size_t chunk = count - done;
+        if (chunk > PACKET_BATCH_MAX) {
+            chunk = PACKET_BATCH_MAX;
+        }
+        process_packet_chunk(views + done, chunk, stats);
+    }
+    return stats->accepted;
+}
+
+/* A single packet is a batch of one */
+bool process_packet(const PacketView *view) {
+    if (view == NULL) {
         return false;
     }
-    
-    // Process based on type
-    switch (packet->type) {
-        case 0x01:
-            printf("Processing data packet\n");
-            break;
-            
-        case 0x02:
-            printf("Processing control packet\n");
-            break;
-            
-        case 0x03:
-            printf("Processing status packet\n");
-            break;
-            
-        default:
-            printf("Unknown packet type\n");
-            return false;
+    PacketBatchStats stats;
+    if (process_packet_batch(view, 1, &stats) == 1) {
+        return true;
     }
-    
+    for (size_t r = PACKET_ROUTE_HANDLERS; r < PACKET_ROUTE_COUNT; r++) {
+        if (stats.counts[r] > 0) {
+            printf("%s\n", PACKET_REJECT_MESSAGES[r - PACKET_ROUTE_HANDLERS]);
+        }
+    }
+    return false;
+}
+
+/* Example: A fleet of device state machines.
+ * good_state_machine() is fine for one instance; tens of thousands of
+ * devices each stepping through a switch pay a hard-to-predict branch
+ * per device. Here the transitions are data: compiled once into a dense
+ * table, the fleet's states are one byte each, and a whole column is
+ * advanced with one table lookup per device (AVX2 gathers when
+ * available). */
+typedef enum {
+    DEVICE_INPUT_START,
+    DEVICE_INPUT_PAUSE,
+    DEVICE_INPUT_RESUME,
+    DEVICE_INPUT_STOP,
+    DEVICE_INPUT_FAULT,
+    DEVICE_INPUT_RESET,
+    DEVICE_INPUT_COUNT
+} DeviceInput;
+
+typedef enum {
+    DEVICE_ACTION_NONE = STATE_MACHINE_ACTION_NONE,
+    DEVICE_ACTION_POWER_ON,
+    DEVICE_ACTION_POWER_OFF,
+    DEVICE_ACTION_ALARM,
+    DEVICE_ACTION_COUNT
+} DeviceAction;
+
+#define DEVICE_STATE_COUNT 4  /* STATE_IDLE .. STATE_ERROR */
+
+static const StateTransition DEVICE_TRANSITIONS[] = {
+    {STATE_IDLE,    DEVICE_INPUT_START,  STATE_RUNNING, DEVICE_ACTION_POWER_ON},
+    {STATE_RUNNING, DEVICE_INPUT_PAUSE,  STATE_PAUSED,  DEVICE_ACTION_NONE},
+    {STATE_RUNNING, DEVICE_INPUT_STOP,   STATE_IDLE,    DEVICE_ACTION_POWER_OFF},
+    {STATE_PAUSED,  DEVICE_INPUT_RESUME, STATE_RUNNING, DEVICE_ACTION_NONE},
+    {STATE_PAUSED,  DEVICE_INPUT_STOP,   STATE_IDLE,    DEVICE_ACTION_POWER_OFF},
+    {STATE_IDLE,    DEVICE_INPUT_FAULT,  STATE_ERROR,   DEVICE_ACTION_ALARM},
+    {STATE_RUNNING, DEVICE_INPUT_FAULT,  STATE_ERROR,   DEVICE_ACTION_ALARM},
+    {STATE_PAUSED,  DEVICE_INPUT_FAULT,  STATE_ERROR,   DEVICE_ACTION_ALARM},
+    {STATE_ERROR,   DEVICE_INPUT_RESET,  STATE_IDLE,    DEVICE_ACTION_NONE},
+};
+
+#define DEVICE_FLEET_SIZE 20000
+
+/* Rule 3: the fleet is static */
+static StateMachine g_device_machine;
+static uint8_t g_device_states[DEVICE_FLEET_SIZE];
+static uint8_t g_device_inputs[DEVICE_FLEET_SIZE];
+static uint8_t g_device_actions[DEVICE_FLEET_SIZE];
+
+bool device_fleet_init(void) {
+    if (!state_machine_compile(&g_device_machine, DEVICE_STATE_COUNT, DEVICE_INPUT_COUNT,
+                               STATE_ERROR, DEVICE_TRANSITIONS,
+                               sizeof(DEVICE_TRANSITIONS) / sizeof(DEVICE_TRANSITIONS[0]))) {
+        return false;
+    }
+    memset(g_device_states, STATE_IDLE, sizeof(g_device_states));
     return true;
 }
 
+/* One input per device; counts the actions it triggered */
+void device_fleet_step(size_t action_counts[DEVICE_ACTION_COUNT]) {
+    state_machine_step_batch(&g_device_machine, g_device_states, g_device_inputs,
+                             g_device_actions, DEVICE_FLEET_SIZE);
+    for (size_t i = 0; i < DEVICE_FLEET_SIZE; i++) {
+        if (g_device_actions[i] < DEVICE_ACTION_COUNT) {
+            action_counts[g_device_actions[i]]++;
+        }
+    }
+}
+
 // ============================================
 // MAIN - Demonstrations
 // ============================================
@@ -375,19 +785,74 @@ int main(void) {
     execute_command(cmd);
     cmd = parse_command("STATUS");
     execute_command(cmd);
+    execute_command_line("SET_LIMITS -20 85");
+    execute_command_line("SET_RATE");
+    execute_command_line("LAUNCH");
     printf("\n");
     
     // Test 5: Packet processing
     printf("Test 5: Packet Processing\n");
-    Packet packet = {
-        .header = 0xAA,
-        .type = 0x01,
-        .length = 5,
-        .data = {1, 2, 3, 4, 5},
-        .checksum = 1 ^ 2 ^ 3 ^ 4 ^ 5
-    };
-    process_packet(&packet);
-    
+    static uint8_t rx_buffer[2048];  /* As filled by the receiver */
+    const uint8_t payload[5] = {1, 2, 3, 4, 5};
+    PacketView view = {rx_buffer, packet_encode(rx_buffer, sizeof(rx_buffer), 0x01, payload, 5)};
+    process_packet(&view);
+
+    // Same bit flipped in two bytes: invisible to a byte XOR, not to CRC32C
+    rx_buffer[PACKET_PREFIX_SIZE + 0] ^= 0x10;
+    rx_buffer[PACKET_PREFIX_SIZE + 3] ^= 0x10;
+    printf("Corrupted packet (XOR %s): ",
+           checksum_xor8(packet_payload(&view), 5) == (1 ^ 2 ^ 3 ^ 4 ^ 5) ? "unchanged" : "changed");
+    process_packet(&view);
+    printf("\n");
+
+    // Test 6: Batched packet processing, straight from the receive buffer
+    printf("Test 6: Batched Packet Processing\n");
+    size_t received = 0;
+    size_t frame_offsets[8];
+    for (size_t i = 0; i < 8; i++) {
+        uint8_t data[32];
+        for (size_t j = 0; j < sizeof(data); j++) {
+            data[j] = (uint8_t)(i * j);
+        }
+        frame_offsets[i] = received;
+        received += packet_encode(rx_buffer + received, sizeof(rx_buffer) - received,
+                                  (uint8_t)(1 + i % 3), data, (uint16_t)(16 + i));
+    }
+    rx_buffer[frame_offsets[2] + PACKET_PREFIX_SIZE] ^= 1u;  // Corrupted in transit
+    rx_buffer[frame_offsets[5]] = 0x55;                     // Not a packet
+    PacketView views[8];
+    size_t consumed = 0;
+    size_t skipped = 0;
+    size_t frames = packet_split(rx_buffer, received, views, 8, &consumed, &skipped);
+    PacketBatchStats stats;
+    size_t handled = process_packet_batch(views, frames, &stats);
+    printf("Handled %zu of %zu frames, %zu bytes (%zu bytes rejected while resyncing)\n",
+           handled, frames, consumed, skipped);
+
+    printf("\n");
+
+    // Test 7: Device fleet
+    printf("Test 7: Device Fleet (%d state machines)\n", DEVICE_FLEET_SIZE);
+    if (device_fleet_init()) {
+        size_t actions[DEVICE_ACTION_COUNT] = {0};
+        uint32_t lcg = 12345;
+        for (int round = 0; round < 10; round++) {
+            for (size_t i = 0; i < DEVICE_FLEET_SIZE; i++) {
+                lcg = lcg * 1103515245u + 12345u;
+                g_device_inputs[i] = (uint8_t)((lcg >> 16) % DEVICE_INPUT_COUNT);
+            }
+            device_fleet_step(actions);
+        }
+        size_t per_state[DEVICE_STATE_COUNT] = {0};
+        for (size_t i = 0; i < DEVICE_FLEET_SIZE; i++) {
+            per_state[g_device_states[i]]++;
+        }
+        printf("After 10 rounds: %zu idle, %zu running, %zu paused, %zu error\n", per_state[STATE_IDLE],
+               per_state[STATE_RUNNING], per_state[STATE_PAUSED], per_state[STATE_ERROR]);
+        printf("Actions: %zu power on, %zu power off, %zu alarms\n", actions[DEVICE_ACTION_POWER_ON],
+               actions[DEVICE_ACTION_POWER_OFF], actions[DEVICE_ACTION_ALARM]);
+    }
+
     printf("\n✅ Rule 1 Examples Complete\n");
     return 0;
 }
@@ -4,15 +4,19 @@
  * All loops must have a fixed upper bound
  * Must be able to prove loop termination
  * 
- * Compilation: gcc -Wall -Wextra -Werror -std=c11 rule02_loop_bounds.c
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -I../common rule02_loop_bounds.c ../common/reduce.c ../common/cpu_features.c
  */
 
+#define _POSIX_C_SOURCE 200809L  // strnlen
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
+#include "reduce.h"
+
 #define MAX_BUFFER_SIZE 256
 #define MAX_ITERATIONS 1000
 #define MAX_ARRAY_SIZE 100
@@ -113,13 +117,8 @@ size_t good_string_length(const char *str) {
         return 0;
     }
     
-    size_t len = 0;
     // Guaranteed termination within MAX_BUFFER_SIZE
-    while (len < MAX_BUFFER_SIZE && str[len] != '\0') {
-        len++;
-    }
-    
-    return len;
+    return strnlen(str, MAX_BUFFER_SIZE);
 }
 
 /* GOOD: Nested loops with fixed bounds */
@@ -313,13 +312,10 @@ int filter_get_average(const MovingAverageFilter *filter) {
         return 0;
     }
     
-    int sum = 0;
-    // Fixed bound - always FILTER_SIZE
-    for (size_t i = 0; i < FILTER_SIZE; i++) {
-        sum += filter->samples[i];
-    }
+    // Fixed bound - always FILTER_SIZE, summed in 64 bits
+    int64_t sum = reduce_sum_int(filter->samples, FILTER_SIZE);
     
-    return sum / FILTER_SIZE;
+    return (int)(sum / FILTER_SIZE);
 }
 
 /* Example 5: Matrix operations */
@@ -4,7 +4,7 @@
  * No malloc/free after initialization
  * Use static allocation or pre-allocated pools
  * 
- * Compilation: gcc -Wall -Wextra -Werror -std=c11 rule03_no_dynamic_memory.c
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -I../common rule03_no_dynamic_memory.c ../common/reduce.c ../common/cpu_features.c
  */
 
 #include <stdio.h>
@@ -14,6 +14,8 @@
 #include <stdbool.h>
 #include <assert.h>
 
+#include "reduce.h"
+
 #define MAX_OBJECTS 32
 #define MAX_BUFFER_SIZE 256
 #define MAX_EVENTS 64
@@ -434,16 +436,16 @@ void telemetry_get_stats(float *avg_temp, float *avg_pressure) {
         return;
     }
     
-    float temp_sum = 0.0f;
-    float pressure_sum = 0.0f;
-    
-    for (size_t i = 0; i < g_telemetry.count; i++) {
-        temp_sum += g_telemetry.samples[i].temperature;
-        pressure_sum += g_telemetry.samples[i].pressure;
-    }
+    // Strided sums over the fixed pool, accumulated in double: a float
+    // accumulator stops absorbing samples once it is 2^24 times larger
+    const TelemetrySample *samples = g_telemetry.samples;
+    double temp_sum = reduce_sum_float(&samples[0].temperature, g_telemetry.count,
+                                       sizeof(TelemetrySample));
+    double pressure_sum = reduce_sum_float(&samples[0].pressure, g_telemetry.count,
+                                           sizeof(TelemetrySample));
     
-    *avg_temp = temp_sum / g_telemetry.count;
-    *avg_pressure = pressure_sum / g_telemetry.count;
+    *avg_temp = (float)(temp_sum / (double)g_telemetry.count);
+    *avg_pressure = (float)(pressure_sum / (double)g_telemetry.count);
 }
 
 // ============================================
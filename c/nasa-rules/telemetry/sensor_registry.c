@@ -0,0 +1,163 @@
+/*
+ * SENSOR REGISTRY - Implementation
+ */
+
+#include "sensor_registry.h"
+
+#include <assert.h>
+#include <string.h>
+
+_Static_assert(SENSOR_INDEX_SIZE >= 2 * SENSOR_REGISTRY_CAPACITY,
+               "index load factor must stay <= 1/2");
+_Static_assert(SENSOR_REGISTRY_CAPACITY < UINT16_MAX,
+               "handle slots are stored as uint16_t + 1");
+
+#define INDEX_MASK (SENSOR_INDEX_SIZE - 1)
+
+// ============================================
+// HASH INDEX (linear probing)
+// ============================================
+
+/* Fibonacci hashing: spreads sequential ids across the table */
+static size_t home_bucket(int id) {
+    return (size_t)(((uint32_t)id * 0x9E3779B1u) >> (32 - SENSOR_INDEX_BITS));
+}
+
+/* Bucket holding id, or the empty bucket where it would go */
+static size_t find_bucket(const SensorRegistry *registry, int id) {
+    size_t bucket = home_bucket(id);
+    // Rule 2: The table always has empty buckets (load <= 1/2)
+    for (size_t probe = 0; probe < SENSOR_INDEX_SIZE; probe++) {
+        const SensorIndexEntry *entry = &registry->index[bucket];
+        if (entry->handle == 0 || entry->id == id) {
+            return bucket;
+        }
+        bucket = (bucket + 1) & INDEX_MASK;
+    }
+    assert(0);  // Unreachable while count <= capacity
+    return bucket;
+}
+
+/* Remove bucket and shift later entries of the cluster back */
+static void erase_bucket(SensorRegistry *registry, size_t hole) {
+    size_t bucket = hole;
+    for (size_t probe = 0; probe < SENSOR_INDEX_SIZE; probe++) {
+        bucket = (bucket + 1) & INDEX_MASK;
+        SensorIndexEntry *entry = &registry->index[bucket];
+        if (entry->handle == 0) {
+            break;
+        }
+        // Move the entry if its home is not in (hole, bucket]
+        size_t distance_home = (bucket - home_bucket(entry->id)) & INDEX_MASK;
+        size_t distance_hole = (bucket - hole) & INDEX_MASK;
+        if (distance_home >= distance_hole) {
+            registry->index[hole] = *entry;
+            hole = bucket;
+        }
+    }
+    registry->index[hole].handle = 0;
+}
+
+// ============================================
+// REGISTRY
+// ============================================
+
+void sensor_registry_init(SensorRegistry *registry) {
+    assert(registry != NULL);
+
+    memset(registry->index, 0, sizeof(registry->index));
+    memset(registry->handles, 0, sizeof(registry->handles));
+    registry->count = 0;
+
+    // Hand out low slots first
+    registry->free_count = SENSOR_REGISTRY_CAPACITY;
+    for (size_t i = 0; i < SENSOR_REGISTRY_CAPACITY; i++) {
+        registry->free_handles[i] = (uint16_t)(SENSOR_REGISTRY_CAPACITY - 1 - i);
+    }
+}
+
+bool sensor_registry_add(SensorRegistry *registry, int id, int value, SensorHandle *handle) {
+    assert(registry != NULL);
+
+    if (registry->count >= SENSOR_REGISTRY_CAPACITY) {
+        return false;  // Registry full
+    }
+    size_t bucket = find_bucket(registry, id);
+    if (registry->index[bucket].handle != 0) {
+        return false;  // Duplicate id
+    }
+
+    uint16_t slot = registry->free_handles[--registry->free_count];
+    uint16_t dense = (uint16_t)registry->count++;
+
+    registry->sensors[dense] = (Sensor){ id, value };
+    registry->owner[dense] = slot;
+    registry->handles[slot].dense = dense;
+    registry->index[bucket] = (SensorIndexEntry){ id, (uint16_t)(slot + 1) };
+
+    if (handle != NULL) {
+        *handle = (SensorHandle){ slot, registry->handles[slot].generation };
+    }
+    return true;
+}
+
+Sensor *sensor_registry_find(SensorRegistry *registry, int id) {
+    assert(registry != NULL);
+
+    const SensorIndexEntry *entry = &registry->index[find_bucket(registry, id)];
+    if (entry->handle == 0) {
+        return NULL;
+    }
+    return &registry->sensors[registry->handles[entry->handle - 1].dense];
+}
+
+bool sensor_registry_handle(const SensorRegistry *registry, int id, SensorHandle *handle) {
+    assert(registry != NULL);
+    assert(handle != NULL);
+
+    const SensorIndexEntry *entry = &registry->index[find_bucket(registry, id)];
+    if (entry->handle == 0) {
+        return false;
+    }
+    uint16_t slot = (uint16_t)(entry->handle - 1);
+    *handle = (SensorHandle){ slot, registry->handles[slot].generation };
+    return true;
+}
+
+Sensor *sensor_registry_get(SensorRegistry *registry, SensorHandle handle) {
+    assert(registry != NULL);
+
+    if (handle.slot >= SENSOR_REGISTRY_CAPACITY) {
+        return NULL;
+    }
+    const SensorHandleSlot *slot = &registry->handles[handle.slot];
+    // A freed slot has a bumped generation; a reused one a newer one still
+    if (slot->generation != handle.generation || slot->dense >= registry->count
+        || registry->owner[slot->dense] != handle.slot) {
+        return NULL;
+    }
+    return &registry->sensors[slot->dense];
+}
+
+bool sensor_registry_remove(SensorRegistry *registry, int id) {
+    assert(registry != NULL);
+
+    size_t bucket = find_bucket(registry, id);
+    if (registry->index[bucket].handle == 0) {
+        return false;
+    }
+    uint16_t slot = (uint16_t)(registry->index[bucket].handle - 1);
+    uint16_t hole = registry->handles[slot].dense;
+    uint16_t last = (uint16_t)(registry->count - 1);
+
+    // Swap-remove: move the last sensor into the hole, patch its handle
+    registry->sensors[hole] = registry->sensors[last];
+    registry->owner[hole] = registry->owner[last];
+    registry->handles[registry->owner[hole]].dense = hole;
+    registry->count--;
+
+    registry->handles[slot].generation++;
+    registry->free_handles[registry->free_count++] = slot;
+    erase_bucket(registry, bucket);
+    return true;
+}
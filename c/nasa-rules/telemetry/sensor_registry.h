@@ -0,0 +1,87 @@
+/*
+ * SENSOR REGISTRY - O(1) id lookup, O(1) removal, dense iteration
+ *
+ * Sensors live in a dense array (sensors[0..count)) so iterating them is
+ * a linear scan with no holes. Three fixed tables keep every operation
+ * O(1) without malloc:
+ *
+ *   index    open-addressing hash table, id -> handle slot. It uses
+ *            linear probing with backward-shift deletion, so there are
+ *            no tombstones and churn does not degrade lookups.
+ *            Load <= 1/2.
+ *   handles  stable handle slot -> dense position + generation
+ *   owner    dense position -> handle slot (to patch the handle of the
+ *            sensor moved by a swap-remove)
+ *
+ * Removal swaps the last sensor into the hole. SensorHandle carries a
+ * generation, so a handle to a removed sensor is rejected even after its
+ * slot is reused. Pointers returned by find/get are invalidated by the
+ * next add or remove.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c sensor_registry.c
+ */
+
+#ifndef SENSOR_REGISTRY_H
+#define SENSOR_REGISTRY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef SENSOR_REGISTRY_CAPACITY
+#define SENSOR_REGISTRY_CAPACITY 4096  /* Max live sensors (Rule 3: fixed) */
+#endif
+
+#define SENSOR_INDEX_BITS 13           /* 2 * capacity buckets */
+#define SENSOR_INDEX_SIZE (1u << SENSOR_INDEX_BITS)
+
+typedef struct {
+    int id;
+    int value;
+} Sensor;
+
+typedef struct {
+    uint16_t slot;
+    uint32_t generation;
+} SensorHandle;
+
+typedef struct {
+    int id;
+    uint16_t handle;  /* Handle slot + 1; 0 marks an empty bucket */
+} SensorIndexEntry;
+
+typedef struct {
+    uint16_t dense;       /* Position in sensors[] while live */
+    uint32_t generation;  /* Bumped on removal */
+} SensorHandleSlot;
+
+typedef struct {
+    Sensor sensors[SENSOR_REGISTRY_CAPACITY];        /* Dense, iteration order */
+    uint16_t owner[SENSOR_REGISTRY_CAPACITY];        /* Dense -> handle slot */
+    SensorHandleSlot handles[SENSOR_REGISTRY_CAPACITY];
+    uint16_t free_handles[SENSOR_REGISTRY_CAPACITY]; /* Stack of free slots */
+    size_t free_count;
+    SensorIndexEntry index[SENSOR_INDEX_SIZE];
+    size_t count;
+} SensorRegistry;
+
+/* Empty the registry */
+void sensor_registry_init(SensorRegistry *registry);
+
+/* Register a sensor; false if the id exists or the registry is full.
+ * handle may be NULL. */
+bool sensor_registry_add(SensorRegistry *registry, int id, int value, SensorHandle *handle);
+
+/* Sensor with this id, or NULL */
+Sensor *sensor_registry_find(SensorRegistry *registry, int id);
+
+/* Sensor behind a handle, or NULL if it was removed */
+Sensor *sensor_registry_get(SensorRegistry *registry, SensorHandle handle);
+
+/* Handle of a registered id; false if absent */
+bool sensor_registry_handle(const SensorRegistry *registry, int id, SensorHandle *handle);
+
+/* Unregister; the last sensor moves into the freed position */
+bool sensor_registry_remove(SensorRegistry *registry, int id);
+
+#endif /* SENSOR_REGISTRY_H */
@@ -0,0 +1,296 @@
+/*
+ * SENSOR STATS - Implementation
+ */
+
+#include "sensor_stats.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "reduce.h"
+
+_Static_assert(SENSOR_STATS_INDEX_SIZE >= 2 * SENSOR_STATS_CAPACITY,
+               "index load factor must stay <= 1/2");
+_Static_assert(SENSOR_STATS_CAPACITY < UINT16_MAX,
+               "groups are stored as uint16_t + 1");
+_Static_assert(SENSOR_STATS_BATCH_MAX < UINT16_MAX,
+               "batch offsets are stored as uint16_t");
+
+#define INDEX_MASK (SENSOR_STATS_INDEX_SIZE - 1)
+#define NO_GROUP SIZE_MAX
+#define NO_LOCAL UINT16_MAX
+#define SENSOR_STATS_SIMD_RUN 256  // Shorter runs do not amortize the kernel calls
+#define SENSOR_STATS_MIN_RUN 8     // Shorter average runs are not worth partitioning
+
+// ============================================
+// ID -> GROUP INDEX (linear probing, insert only)
+// ============================================
+
+/* Fibonacci hashing: spreads sequential ids across the table */
+static size_t home_bucket(int id) {
+    return (size_t)(((uint32_t)id * 0x9E3779B1u) >> (32 - SENSOR_STATS_INDEX_BITS));
+}
+
+/* Bucket holding id, or the empty bucket where it would go */
+static size_t find_bucket(const SensorStats *stats, int id) {
+    size_t bucket = home_bucket(id);
+    // Rule 2: The table always has empty buckets (load <= 1/2)
+    for (size_t probe = 0; probe < SENSOR_STATS_INDEX_SIZE; probe++) {
+        const SensorStatsIndexEntry *entry = &stats->index[bucket];
+        if (entry->group == 0 || entry->id == id) {
+            return bucket;
+        }
+        bucket = (bucket + 1) & INDEX_MASK;
+    }
+    assert(0);  // Unreachable while group_count <= capacity
+    return bucket;
+}
+
+/* Group of id, created on first sight; NO_GROUP when the table is full */
+static size_t group_for(SensorStats *stats, int id) {
+    size_t bucket = find_bucket(stats, id);
+    SensorStatsIndexEntry *entry = &stats->index[bucket];
+    if (entry->group != 0) {
+        return (size_t)entry->group - 1;
+    }
+    if (stats->group_count == SENSOR_STATS_CAPACITY) {
+        return NO_GROUP;
+    }
+
+    size_t group = stats->group_count++;
+    entry->id = id;
+    entry->group = (uint16_t)(group + 1);
+
+    SensorGroupStats *g = &stats->groups[group];
+    memset(g, 0, sizeof(*g));
+    g->sensor_id = id;
+    return group;
+}
+
+// ============================================
+// GROUP UPDATES
+// ============================================
+
+static void note_time(SensorGroupStats *group, uint32_t timestamp, uint64_t time_ns) {
+    if (timestamp > group->last_timestamp) {
+        group->last_timestamp = timestamp;
+    }
+    if (time_ns > group->last_time_ns) {
+        group->last_time_ns = time_ns;
+    }
+}
+
+/* Welford: one sample */
+static void add_value(SensorGroupStats *group, double value) {
+    if (group->count == 0) {
+        group->min = value;
+        group->max = value;
+    } else {
+        group->min = (value < group->min) ? value : group->min;
+        group->max = (value > group->max) ? value : group->max;
+    }
+
+    group->count++;
+    double delta = value - group->mean;
+    group->mean += delta / (double)group->count;
+    group->m2 += delta * (value - group->mean);
+}
+
+/* Mean, variance, min and max of a run. Long runs use the compensated
+ * SIMD kernels; short ones are cheaper inline. */
+static void run_aggregates(const double *values, size_t count, double *mean,
+                           double *variance, double *min, double *max) {
+    if (count >= SENSOR_STATS_SIMD_RUN) {
+        reduce_mean_variance(values, count, mean, variance);
+        reduce_min_max_double(values, count, min, max);
+        return;
+    }
+
+    double sum = 0.0;
+    *min = values[0];
+    *max = values[0];
+    for (size_t i = 0; i < count; i++) {
+        sum += values[i];
+        *min = (values[i] < *min) ? values[i] : *min;
+        *max = (values[i] > *max) ? values[i] : *max;
+    }
+    *mean = sum / (double)count;
+
+    double squares = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        double d = values[i] - *mean;
+        squares += d * d;
+    }
+    *variance = squares / (double)count;
+}
+
+/* Chan et al.: merge the aggregates of a run of values */
+static void add_run(SensorGroupStats *group, const double *values, size_t count) {
+    double run_mean;
+    double run_variance;
+    double run_min;
+    double run_max;
+    run_aggregates(values, count, &run_mean, &run_variance, &run_min, &run_max);
+
+    double na = (double)group->count;
+    double nb = (double)count;
+    double n = na + nb;
+    double delta = run_mean - group->mean;
+
+    if (group->count == 0) {
+        group->min = run_min;
+        group->max = run_max;
+    } else {
+        group->min = (run_min < group->min) ? run_min : group->min;
+        group->max = (run_max > group->max) ? run_max : group->max;
+    }
+    group->mean += delta * (nb / n);
+    group->m2 += run_variance * nb + delta * delta * (na * nb / n);
+    group->count += count;
+}
+
+/* Local id of group within the current batch, assigned on first sight */
+static size_t local_for(SensorStats *stats, size_t group) {
+    if (stats->group_batch[group] == stats->batch_id) {
+        return stats->group_local[group];
+    }
+    size_t local = stats->local_count++;
+    stats->group_batch[group] = stats->batch_id;
+    stats->group_local[group] = (uint16_t)local;
+    stats->local_group[local] = (uint16_t)group;
+    stats->local_fill[local] = 0;
+    return local;
+}
+
+/* One counting-sort pass over at most SENSOR_STATS_BATCH_MAX samples */
+static size_t update_chunk(SensorStats *stats, const TelemetryData *samples, size_t count) {
+    assert(count <= SENSOR_STATS_BATCH_MAX);
+
+    // Stamps make the group -> local map valid without clearing it
+    if (++stats->batch_id == 0) {
+        memset(stats->group_batch, 0, sizeof(stats->group_batch));
+        stats->batch_id = 1;
+    }
+    stats->local_count = 0;
+
+    size_t keyed = 0;
+
+    // Pass 1: resolve groups (consecutive samples of a sensor share the
+    // probe) and count samples per local group
+    size_t group = NO_GROUP;
+    int group_id = 0;
+    for (size_t i = 0; i < count; i++) {
+        stats->sample_local[i] = NO_LOCAL;
+        if (!samples[i].valid) {
+            continue;
+        }
+        if (group == NO_GROUP || samples[i].sensor_id != group_id) {
+            group_id = samples[i].sensor_id;
+            group = group_for(stats, group_id);
+            if (group == NO_GROUP) {
+                continue;
+            }
+        }
+        size_t local = local_for(stats, group);
+        stats->sample_local[i] = (uint16_t)local;
+        stats->local_fill[local]++;
+        keyed++;
+        note_time(&stats->groups[group], samples[i].timestamp, samples[i].time_ns);
+    }
+
+    // Fragmented batch (e.g. round-robin over many sensors): the groups
+    // are already resolved, fold sample by sample instead of scattering
+    if (keyed < stats->local_count * SENSOR_STATS_MIN_RUN) {
+        for (size_t i = 0; i < count; i++) {
+            size_t local = stats->sample_local[i];
+            if (local != NO_LOCAL) {
+                add_value(&stats->groups[stats->local_group[local]], samples[i].temperature);
+            }
+        }
+        return keyed;
+    }
+
+    // Counts -> run offsets; local_start[local_count] ends the last run
+    size_t offset = 0;
+    for (size_t local = 0; local < stats->local_count; local++) {
+        size_t run = stats->local_fill[local];
+        stats->local_start[local] = (uint16_t)offset;
+        stats->local_fill[local] = (uint16_t)offset;
+        offset += run;
+    }
+    stats->local_start[stats->local_count] = (uint16_t)offset;
+    assert(offset == keyed);
+
+    // Pass 2: scatter values so each sensor's run is contiguous (stable)
+    for (size_t i = 0; i < count; i++) {
+        size_t local = stats->sample_local[i];
+        if (local != NO_LOCAL) {
+            stats->values[stats->local_fill[local]++] = samples[i].temperature;
+        }
+    }
+
+    // One merge per sensor present in the batch
+    for (size_t local = 0; local < stats->local_count; local++) {
+        size_t run_start = stats->local_start[local];
+        add_run(&stats->groups[stats->local_group[local]], &stats->values[run_start],
+                stats->local_start[local + 1] - run_start);
+    }
+    return keyed;
+}
+
+// ============================================
+// PUBLIC API
+// ============================================
+
+void sensor_stats_init(SensorStats *stats) {
+    assert(stats != NULL);
+
+    memset(stats->index, 0, sizeof(stats->index));
+    memset(stats->group_batch, 0, sizeof(stats->group_batch));
+    stats->group_count = 0;
+    stats->batch_id = 0;
+    stats->local_count = 0;
+}
+
+bool sensor_stats_update(SensorStats *stats, const TelemetryData *sample) {
+    assert(stats != NULL && sample != NULL);
+
+    if (!sample->valid) {
+        return true;
+    }
+    size_t group = group_for(stats, sample->sensor_id);
+    if (group == NO_GROUP) {
+        return false;
+    }
+
+    SensorGroupStats *g = &stats->groups[group];
+    add_value(g, sample->temperature);
+    note_time(g, sample->timestamp, sample->time_ns);
+    return true;
+}
+
+size_t sensor_stats_update_batch(SensorStats *stats, const TelemetryData *samples, size_t count) {
+    assert(stats != NULL && (samples != NULL || count == 0));
+
+    size_t aggregated = 0;
+    // Rule 2: Bounded by count / SENSOR_STATS_BATCH_MAX passes
+    for (size_t offset = 0; offset < count; offset += SENSOR_STATS_BATCH_MAX) {
+        size_t chunk = count - offset;
+        chunk = (chunk < SENSOR_STATS_BATCH_MAX) ? chunk : SENSOR_STATS_BATCH_MAX;
+        aggregated += update_chunk(stats, samples + offset, chunk);
+    }
+    return aggregated;
+}
+
+const SensorGroupStats *sensor_stats_find(const SensorStats *stats, int sensor_id) {
+    assert(stats != NULL);
+
+    const SensorStatsIndexEntry *entry = &stats->index[find_bucket(stats, sensor_id)];
+    return (entry->group != 0) ? &stats->groups[entry->group - 1] : NULL;
+}
+
+double sensor_group_variance(const SensorGroupStats *group) {
+    assert(group != NULL);
+
+    return (group->count < 2) ? 0.0 : group->m2 / (double)group->count;
+}
@@ -0,0 +1,92 @@
+/*
+ * SENSOR STATS - Per-sensor group-by aggregates over telemetry
+ *
+ * One SensorGroupStats per sensor_id holds the running count, mean,
+ * variance (Welford M2), min, max and latest timestamps. Groups live in
+ * a dense array (groups[0..group_count), first-seen order) found through
+ * an open-addressing id -> group index, so one sample costs one probe
+ * and O(1) arithmetic.
+ *
+ * sensor_stats_update_batch() partitions a batch by sensor first: a
+ * counting sort over the sensors present in the batch (O(n), stable)
+ * makes each sensor's values contiguous. Each run is folded in registers
+ * (the reduce kernels for long runs) and merged into its group with one
+ * Chan et al. update, so the per-sample division of Welford's update
+ * and the dependent read-modify-write of the group disappear. Batches
+ * whose runs would average under 8 samples (round-robin over many
+ * sensors) skip the scatter and fold sample by sample.
+ *
+ * Samples with valid == false are ignored. Groups are never removed;
+ * sensor_stats_init() starts over.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -I../../common -c sensor_stats.c
+ */
+
+#ifndef SENSOR_STATS_H
+#define SENSOR_STATS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "telemetry_types.h"
+
+#ifndef SENSOR_STATS_CAPACITY
+#define SENSOR_STATS_CAPACITY 4096     /* Max distinct sensors (Rule 3: fixed) */
+#endif
+
+#define SENSOR_STATS_INDEX_BITS 13     /* 2 * capacity buckets */
+#define SENSOR_STATS_INDEX_SIZE (1u << SENSOR_STATS_INDEX_BITS)
+#define SENSOR_STATS_BATCH_BITS 10
+#define SENSOR_STATS_BATCH_MAX (1u << SENSOR_STATS_BATCH_BITS)  /* Per partition pass */
+
+typedef struct {
+    int sensor_id;
+    uint32_t last_timestamp;  /* Latest Unix seconds seen */
+    uint64_t last_time_ns;    /* Latest monotonic capture time seen */
+    uint64_t count;
+    double mean;
+    double m2;                /* Sum of squared deviations from the mean */
+    double min;
+    double max;
+} SensorGroupStats;
+
+typedef struct {
+    int id;
+    uint16_t group;  /* Group + 1; 0 marks an empty bucket */
+} SensorStatsIndexEntry;
+
+typedef struct {
+    SensorGroupStats groups[SENSOR_STATS_CAPACITY];  /* Dense, first-seen order */
+    size_t group_count;
+    SensorStatsIndexEntry index[SENSOR_STATS_INDEX_SIZE];
+    /* Batch partition state (Rule 3: no malloc) */
+    uint32_t batch_id;                                /* Current batch stamp */
+    uint32_t group_batch[SENSOR_STATS_CAPACITY];      /* Stamp of group_local */
+    uint16_t group_local[SENSOR_STATS_CAPACITY];      /* Group -> local id */
+    uint16_t local_group[SENSOR_STATS_BATCH_MAX];     /* Local id -> group */
+    uint16_t local_start[SENSOR_STATS_BATCH_MAX + 1]; /* Run offsets in values */
+    uint16_t local_fill[SENSOR_STATS_BATCH_MAX];      /* Counts, then cursors */
+    uint16_t sample_local[SENSOR_STATS_BATCH_MAX];    /* Sample -> local id */
+    size_t local_count;
+    double values[SENSOR_STATS_BATCH_MAX];            /* Partitioned by sensor */
+} SensorStats;
+
+/* Drop every group */
+void sensor_stats_init(SensorStats *stats);
+
+/* Fold one sample into its sensor's group; false if a new sensor does
+ * not fit */
+bool sensor_stats_update(SensorStats *stats, const TelemetryData *sample);
+
+/* Fold count samples; returns how many were aggregated (invalid samples
+ * and samples of sensors that do not fit are skipped) */
+size_t sensor_stats_update_batch(SensorStats *stats, const TelemetryData *samples, size_t count);
+
+/* Group of sensor_id, or NULL if no sample was seen */
+const SensorGroupStats *sensor_stats_find(const SensorStats *stats, int sensor_id);
+
+/* Population variance of a group (0 for fewer than 2 samples) */
+double sensor_group_variance(const SensorGroupStats *group);
+
+#endif /* SENSOR_STATS_H */
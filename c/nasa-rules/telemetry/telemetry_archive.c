@@ -0,0 +1,391 @@
+/*
+ * TELEMETRY ARCHIVE - Implementation
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "telemetry_archive.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define INDEX_ENTRY_SIZE 4
+#define MAX_IO_RETRIES 1000  // Rule 2: bound partial read/write loops
+
+// ============================================
+// FILE HELPERS
+// ============================================
+
+static bool index_path(char *out, const char *path) {
+    int n = snprintf(out, TELEMETRY_ARCHIVE_MAX_PATH, "%s.idx", path);
+    return n > 0 && n < TELEMETRY_ARCHIVE_MAX_PATH;
+}
+
+static bool pwrite_all(int fd, const uint8_t *data, size_t size, off_t offset) {
+    size_t written = 0;
+    for (int attempt = 0; attempt < MAX_IO_RETRIES && written < size; attempt++) {
+        ssize_t n = pwrite(fd, data + written, size - written, offset + (off_t)written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        written += (size_t)n;
+    }
+    return written == size;
+}
+
+static bool pread_all(int fd, uint8_t *data, size_t size, off_t offset) {
+    size_t done = 0;
+    for (int attempt = 0; attempt < MAX_IO_RETRIES && done < size; attempt++) {
+        ssize_t n = pread(fd, data + done, size - done, offset + (off_t)done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        done += (size_t)n;
+    }
+    return done == size;
+}
+
+static bool file_size(int fd, size_t *size) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 0) {
+        return false;
+    }
+    *size = (size_t)st.st_size;
+    return true;
+}
+
+/* Blocks present in both files (a torn tail is ignored) */
+static size_t complete_blocks(size_t data_size, size_t index_size) {
+    size_t data_blocks = data_size / TELEMETRY_ARCHIVE_BLOCK_SIZE;
+    size_t index_blocks = index_size / INDEX_ENTRY_SIZE;
+    return (data_blocks < index_blocks) ? data_blocks : index_blocks;
+}
+
+static uint32_t load_u32(const uint8_t *in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8)
+           | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+static void store_u32(uint8_t *out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+// ============================================
+// WRITER
+// ============================================
+
+/* Timestamp of the last sample of the last sealed block */
+static bool recover_last_timestamp(TelemetryArchiveWriter *writer) {
+    static TelemetryDecoder decoder;  // Rule 3: ~5 KiB kept off the stack
+    off_t offset = (off_t)((writer->block_count - 1) * TELEMETRY_ARCHIVE_BLOCK_SIZE);
+
+    if (!pread_all(writer->data_fd, writer->block, TELEMETRY_ARCHIVE_BLOCK_SIZE, offset)
+        || !telemetry_decoder_open(&decoder, writer->block, TELEMETRY_ARCHIVE_BLOCK_SIZE)) {
+        return false;
+    }
+
+    TelemetryData sample;
+    // Rule 2: Bounded by the block sample count
+    while (telemetry_decoder_next(&decoder, &sample)) {
+        writer->last_timestamp = sample.timestamp;
+        writer->has_samples = true;
+    }
+    return decoder.position == decoder.count;
+}
+
+bool telemetry_archive_writer_open(TelemetryArchiveWriter *writer, const char *path) {
+    assert(writer != NULL);
+    assert(path != NULL);
+
+    char idx[TELEMETRY_ARCHIVE_MAX_PATH];
+    writer->data_fd = -1;
+    writer->index_fd = -1;
+    writer->block_count = 0;
+    writer->has_samples = false;
+    writer->failed = false;
+    telemetry_encoder_reset(&writer->encoder);
+
+    if (!index_path(idx, path)) {
+        return false;
+    }
+    writer->data_fd = open(path, O_RDWR | O_CREAT, 0666);
+    writer->index_fd = open(idx, O_RDWR | O_CREAT, 0666);
+
+    size_t data_size = 0;
+    size_t index_size = 0;
+    bool ok = writer->data_fd >= 0 && writer->index_fd >= 0
+              && file_size(writer->data_fd, &data_size)
+              && file_size(writer->index_fd, &index_size);
+    if (ok) {
+        // Drop any slot or entry without its counterpart
+        writer->block_count = complete_blocks(data_size, index_size);
+        ok = ftruncate(writer->data_fd,
+                       (off_t)(writer->block_count * TELEMETRY_ARCHIVE_BLOCK_SIZE)) == 0
+             && ftruncate(writer->index_fd,
+                          (off_t)(writer->block_count * INDEX_ENTRY_SIZE)) == 0;
+    }
+    if (ok && writer->block_count > 0) {
+        ok = recover_last_timestamp(writer);
+    }
+
+    if (!ok) {
+        writer->failed = true;
+        (void)telemetry_archive_writer_close(writer);
+    }
+    return ok;
+}
+
+bool telemetry_archive_flush(TelemetryArchiveWriter *writer) {
+    assert(writer != NULL);
+
+    if (writer->failed || telemetry_encoder_count(&writer->encoder) == 0) {
+        return !writer->failed;
+    }
+
+    size_t size = telemetry_encoder_finish(&writer->encoder, writer->block,
+                                           sizeof(writer->block));
+    assert(size > 0 && size <= TELEMETRY_ARCHIVE_BLOCK_SIZE);
+    memset(&writer->block[size], 0, TELEMETRY_ARCHIVE_BLOCK_SIZE - size);
+
+    // Slot first, then its index entry: readers never see an unwritten slot
+    uint8_t entry[INDEX_ENTRY_SIZE];
+    store_u32(entry, writer->block_first_timestamp);
+    bool ok = pwrite_all(writer->data_fd, writer->block, TELEMETRY_ARCHIVE_BLOCK_SIZE,
+                         (off_t)(writer->block_count * TELEMETRY_ARCHIVE_BLOCK_SIZE))
+              && pwrite_all(writer->index_fd, entry, INDEX_ENTRY_SIZE,
+                            (off_t)(writer->block_count * INDEX_ENTRY_SIZE));
+
+    writer->failed = !ok;
+    writer->block_count++;
+    telemetry_encoder_reset(&writer->encoder);
+    return ok;
+}
+
+bool telemetry_archive_append(TelemetryArchiveWriter *writer, const TelemetryData *sample) {
+    assert(writer != NULL);
+    assert(sample != NULL);
+
+    if (writer->failed) {
+        return false;
+    }
+    if (writer->has_samples && sample->timestamp < writer->last_timestamp) {
+        return false;  // Rule 5: The index relies on time order
+    }
+
+    // Seal before the worst-case sample could overflow the slot
+    size_t bound = telemetry_encoder_size_bound(&writer->encoder);
+    if (bound + TELEMETRY_SAMPLE_MAX_BYTES > TELEMETRY_ARCHIVE_BLOCK_SIZE) {
+        if (!telemetry_archive_flush(writer)) {
+            return false;
+        }
+    }
+    if (!telemetry_encoder_add(&writer->encoder, sample)) {
+        // Sample count or dictionary limit reached
+        if (!telemetry_archive_flush(writer)) {
+            return false;
+        }
+        bool added = telemetry_encoder_add(&writer->encoder, sample);
+        assert(added);  // Rule 7: An empty block takes any sample
+        (void)added;
+    }
+
+    if (telemetry_encoder_count(&writer->encoder) == 1) {
+        writer->block_first_timestamp = sample->timestamp;
+    }
+    writer->last_timestamp = sample->timestamp;
+    writer->has_samples = true;
+    return true;
+}
+
+bool telemetry_archive_writer_close(TelemetryArchiveWriter *writer) {
+    assert(writer != NULL);
+
+    bool ok = (writer->data_fd >= 0) && telemetry_archive_flush(writer);
+    if (writer->data_fd >= 0 && close(writer->data_fd) != 0) {  // Rule 5
+        ok = false;
+    }
+    if (writer->index_fd >= 0 && close(writer->index_fd) != 0) {
+        ok = false;
+    }
+    writer->data_fd = -1;
+    writer->index_fd = -1;
+    return ok;
+}
+
+// ============================================
+// READER
+// ============================================
+
+/* Map size bytes of fd read-only; NULL for an empty region */
+static void *map_file(int fd, size_t size, bool *ok) {
+    if (size == 0) {
+        return NULL;
+    }
+    void *p = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        *ok = false;
+        return NULL;
+    }
+    return p;
+}
+
+bool telemetry_archive_open(TelemetryArchive *archive, const char *path) {
+    assert(archive != NULL);
+    assert(path != NULL);
+
+    char idx[TELEMETRY_ARCHIVE_MAX_PATH];
+    memset(archive, 0, sizeof(*archive));
+    if (!index_path(idx, path)) {
+        return false;
+    }
+
+    int data_fd = open(path, O_RDONLY);
+    int index_fd = open(idx, O_RDONLY);
+    size_t data_size = 0;
+    size_t index_size = 0;
+    bool ok = data_fd >= 0 && index_fd >= 0
+              && file_size(data_fd, &data_size) && file_size(index_fd, &index_size);
+
+    if (ok) {
+        archive->block_count = complete_blocks(data_size, index_size);
+        archive->data_size = archive->block_count * TELEMETRY_ARCHIVE_BLOCK_SIZE;
+        archive->index_size = archive->block_count * INDEX_ENTRY_SIZE;
+        archive->data_map = map_file(data_fd, archive->data_size, &ok);
+        archive->index_map = map_file(index_fd, archive->index_size, &ok);
+        archive->data = archive->data_map;
+        archive->index = archive->index_map;
+    }
+
+    // The mappings stay valid once the descriptors are closed
+    if (data_fd >= 0) {
+        (void)close(data_fd);
+    }
+    if (index_fd >= 0) {
+        (void)close(index_fd);
+    }
+    if (!ok) {
+        telemetry_archive_close(archive);
+    }
+    return ok;
+}
+
+void telemetry_archive_close(TelemetryArchive *archive) {
+    assert(archive != NULL);
+
+    if (archive->data_map != NULL) {
+        (void)munmap(archive->data_map, archive->data_size);
+    }
+    if (archive->index_map != NULL) {
+        (void)munmap(archive->index_map, archive->index_size);
+    }
+    memset(archive, 0, sizeof(*archive));
+}
+
+static uint32_t first_timestamp(const TelemetryArchive *archive, size_t block) {
+    return load_u32(&archive->index[block * INDEX_ENTRY_SIZE]);
+}
+
+/* First block whose first timestamp is > key (or >= key when !inclusive) */
+static size_t search_index(const TelemetryArchive *archive, uint32_t key, bool inclusive) {
+    size_t lo = 0;
+    size_t hi = archive->block_count;
+    // Rule 2: log2(block_count) iterations
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        uint32_t ts = first_timestamp(archive, mid);
+        if (ts < key || (inclusive && ts == key)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* Ask the kernel to read the blocks of the query ahead */
+static void advise_range(const TelemetryArchive *archive, size_t first, size_t end) {
+    long page = sysconf(_SC_PAGESIZE);
+    if (page <= 0 || first >= end) {
+        return;
+    }
+    size_t start = first * TELEMETRY_ARCHIVE_BLOCK_SIZE;
+    size_t aligned = start - start % (size_t)page;
+    size_t length = end * TELEMETRY_ARCHIVE_BLOCK_SIZE - aligned;
+    (void)posix_madvise((uint8_t *)archive->data_map + aligned, length, POSIX_MADV_WILLNEED);
+}
+
+void telemetry_archive_query(TelemetryArchiveQuery *query, const TelemetryArchive *archive,
+                             uint32_t from, uint32_t to) {
+    assert(query != NULL);
+    assert(archive != NULL);
+
+    query->archive = archive;
+    query->from = from;
+    query->to = to;
+    query->block_open = false;
+    query->corrupt = false;
+    query->block = 0;
+    query->end_block = 0;
+    if (from > to || archive->block_count == 0) {
+        return;
+    }
+
+    // Samples at 'from' may sit at the end of the block before the first
+    // block that starts at or after it
+    size_t first = search_index(archive, from, false);
+    query->block = (first > 0) ? first - 1 : 0;
+    query->end_block = search_index(archive, to, true);
+    advise_range(archive, query->block, query->end_block);
+}
+
+bool telemetry_archive_query_next(TelemetryArchiveQuery *query, TelemetryData *sample) {
+    assert(query != NULL);
+    assert(sample != NULL);
+
+    // Rule 2: Bounded by the blocks in range times the samples per block
+    while (query->block_open || query->block < query->end_block) {
+        if (!query->block_open) {
+            const uint8_t *slot = &query->archive->data[query->block * TELEMETRY_ARCHIVE_BLOCK_SIZE];
+            query->block++;
+            if (!telemetry_decoder_open(&query->decoder, slot, TELEMETRY_ARCHIVE_BLOCK_SIZE)) {
+                query->corrupt = true;
+                query->block = query->end_block;
+                return false;
+            }
+            query->block_open = true;
+        }
+
+        while (telemetry_decoder_next(&query->decoder, sample)) {
+            if (sample->timestamp > query->to) {
+                query->block_open = false;  // Time order: nothing later matches
+                query->block = query->end_block;
+                return false;
+            }
+            if (sample->timestamp >= query->from) {
+                return true;
+            }
+        }
+
+        query->block_open = false;
+        if (query->decoder.position != query->decoder.count) {
+            query->corrupt = true;
+            query->block = query->end_block;
+            return false;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,94 @@
+/*
+ * TELEMETRY ARCHIVE - Append-only block file with a time-range index
+ *
+ * An archive is two files:
+ *
+ *   <path>      fixed-size slots of TELEMETRY_ARCHIVE_BLOCK_SIZE bytes,
+ *               each holding one telemetry_codec block (zero-padded)
+ *   <path>.idx  one little-endian u32 per slot: the first timestamp
+ *               of that block
+ *
+ * Samples must be appended in non-decreasing timestamp order, so the
+ * index is sorted and block i covers [first[i], first[i + 1]]. A reader
+ * maps both files and binary-searches the index to decode only the
+ * blocks that overlap a query; nothing else of the archive is touched.
+ *
+ * A slot is written before its index entry. After a crash the shorter
+ * of the two files wins, and reopening for append truncates the
+ * unmatched tail.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c telemetry_archive.c
+ */
+
+#ifndef TELEMETRY_ARCHIVE_H
+#define TELEMETRY_ARCHIVE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "telemetry_codec.h"
+#include "telemetry_types.h"
+
+#define TELEMETRY_ARCHIVE_BLOCK_SIZE 8192  /* Two pages per slot */
+#define TELEMETRY_ARCHIVE_MAX_PATH 256
+
+typedef struct {
+    TelemetryEncoder encoder;
+    uint8_t block[TELEMETRY_BLOCK_MAX_BYTES];  /* Finish scratch */
+    int data_fd;
+    int index_fd;
+    size_t block_count;
+    uint32_t block_first_timestamp;
+    uint32_t last_timestamp;
+    bool has_samples;  /* last_timestamp is meaningful */
+    bool failed;       /* Sticky: set by the first failed write */
+} TelemetryArchiveWriter;
+
+typedef struct {
+    const uint8_t *data;   /* Mapped slots */
+    size_t data_size;
+    const uint8_t *index;  /* Mapped first timestamps */
+    size_t index_size;
+    size_t block_count;
+    void *data_map;        /* The same mappings, as mmap returned them, */
+    void *index_map;       /* for munmap/posix_madvise */
+} TelemetryArchive;
+
+typedef struct {
+    const TelemetryArchive *archive;
+    uint32_t from;
+    uint32_t to;
+    size_t block;      /* Next block to open */
+    size_t end_block;  /* One past the last overlapping block */
+    bool block_open;
+    bool corrupt;      /* A block in range failed to decode */
+    TelemetryDecoder decoder;
+} TelemetryArchiveQuery;
+
+/* Open or create the archive at path for appending */
+bool telemetry_archive_writer_open(TelemetryArchiveWriter *writer, const char *path);
+
+/* Append a sample; false if its timestamp goes backwards or a write failed */
+bool telemetry_archive_append(TelemetryArchiveWriter *writer, const TelemetryData *sample);
+
+/* Seal the pending block so readers can see it */
+bool telemetry_archive_flush(TelemetryArchiveWriter *writer);
+
+/* Flush and close; returns false if any write or close failed */
+bool telemetry_archive_writer_close(TelemetryArchiveWriter *writer);
+
+/* Map the archive at path read-only */
+bool telemetry_archive_open(TelemetryArchive *archive, const char *path);
+
+/* Unmap the archive */
+void telemetry_archive_close(TelemetryArchive *archive);
+
+/* Start iterating the samples with from <= timestamp <= to */
+void telemetry_archive_query(TelemetryArchiveQuery *query, const TelemetryArchive *archive,
+                             uint32_t from, uint32_t to);
+
+/* Next matching sample in archive order; false when done (check corrupt) */
+bool telemetry_archive_query_next(TelemetryArchiveQuery *query, TelemetryData *sample);
+
+#endif /* TELEMETRY_ARCHIVE_H */
@@ -0,0 +1,218 @@
+/*
+ * TELEMETRY ASYNC WRITER - Implementation
+ *
+ * Ownership: buffers[fill] belongs to the producer. While pending is
+ * set, buffers[1 - fill] belongs to the writer thread, and fill does not
+ * change. The writer empties the buffer before clearing pending.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "telemetry_async_writer.h"
+
+#include <assert.h>
+
+#define NS_PER_MS 1000000ull
+
+// ============================================
+// WRITER THREAD
+// ============================================
+
+static bool write_buffer(TelemetryAsyncWriter *writer, TelemetryAsyncBuffer *buffer) {
+    // Rule 2: Bounded by TELEMETRY_ASYNC_BATCH
+    for (size_t i = 0; i < buffer->count; i++) {
+        const TelemetryData *sample = &buffer->samples[i];
+        (void)telemetry_csv_write(&writer->csv, sample->sensor_id,
+                                  sample->temperature, sample->timestamp);
+    }
+    return telemetry_csv_flush(&writer->csv);  // Sticky: reports any failure above
+}
+
+static void *writer_main(void *arg) {
+    TelemetryAsyncWriter *writer = arg;
+
+    pthread_mutex_lock(&writer->lock);
+    // Task loop: runs until telemetry_async_close() sets stop
+    for (;;) {
+        while (!writer->pending && !writer->stop) {
+            pthread_cond_wait(&writer->work, &writer->lock);
+        }
+        if (!writer->pending) {
+            break;  // Stopped with nothing left to write
+        }
+        TelemetryAsyncBuffer *buffer = &writer->buffers[1 - writer->fill];
+        pthread_mutex_unlock(&writer->lock);
+
+        bool ok = write_buffer(writer, buffer);
+
+        pthread_mutex_lock(&writer->lock);
+        if (ok) {
+            writer->stats.samples_written += buffer->count;
+            writer->stats.batches_written++;
+        } else {
+            writer->stats.write_errors++;
+        }
+        buffer->count = 0;
+        writer->pending = false;
+        pthread_cond_broadcast(&writer->idle);
+    }
+    pthread_mutex_unlock(&writer->lock);
+    return NULL;
+}
+
+// ============================================
+// PRODUCER SIDE
+// ============================================
+
+/* Hand buffers[fill] to the writer; false if it is still busy */
+static bool swap_buffers(TelemetryAsyncWriter *writer, bool timed) {
+    pthread_mutex_lock(&writer->lock);
+    if (writer->pending) {
+        pthread_mutex_unlock(&writer->lock);
+        return false;
+    }
+    writer->pending = true;
+    writer->fill = 1 - writer->fill;
+    if (timed) {
+        writer->stats.timed_swaps++;
+    }
+    pthread_cond_signal(&writer->work);
+    pthread_mutex_unlock(&writer->lock);
+
+    writer->last_swap_ns = clock_source_now(&writer->clock);
+    return true;
+}
+
+static bool timer_expired(TelemetryAsyncWriter *writer) {
+    uint64_t now = clock_source_now(&writer->clock);
+    return now - writer->last_swap_ns >= TELEMETRY_ASYNC_FLUSH_MS * NS_PER_MS;
+}
+
+static void wait_idle(TelemetryAsyncWriter *writer) {
+    pthread_mutex_lock(&writer->lock);
+    while (writer->pending) {
+        pthread_cond_wait(&writer->idle, &writer->lock);
+    }
+    pthread_mutex_unlock(&writer->lock);
+}
+
+// ============================================
+// PUBLIC API
+// ============================================
+
+bool telemetry_async_open(TelemetryAsyncWriter *writer, const char *filename) {
+    assert(writer != NULL && filename != NULL);
+
+    writer->running = false;
+    if (!telemetry_csv_open(&writer->csv, filename)) {
+        return false;
+    }
+
+    writer->buffers[0].count = 0;
+    writer->buffers[1].count = 0;
+    writer->fill = 0;
+    writer->pending = false;
+    writer->stop = false;
+    writer->stats = (TelemetryAsyncStats){0};
+    (void)clock_source_init(&writer->clock, CLOCK_SOURCE_COARSE);
+    writer->last_swap_ns = clock_source_now(&writer->clock);
+
+    pthread_mutex_init(&writer->lock, NULL);
+    pthread_cond_init(&writer->work, NULL);
+    pthread_cond_init(&writer->idle, NULL);
+    if (pthread_create(&writer->thread, NULL, writer_main, writer) != 0) {
+        pthread_cond_destroy(&writer->idle);
+        pthread_cond_destroy(&writer->work);
+        pthread_mutex_destroy(&writer->lock);
+        (void)telemetry_csv_close(&writer->csv);
+        return false;
+    }
+    writer->running = true;
+    return true;
+}
+
+bool telemetry_async_append(TelemetryAsyncWriter *writer, const TelemetryData *sample) {
+    assert(writer != NULL && writer->running && sample != NULL);
+
+    TelemetryAsyncBuffer *buffer = &writer->buffers[writer->fill];
+    assert(buffer->count < TELEMETRY_ASYNC_BATCH);  // Rule 7
+    buffer->samples[buffer->count++] = *sample;
+
+    if (buffer->count == TELEMETRY_ASYNC_BATCH) {
+        if (swap_buffers(writer, false)) {
+            return true;
+        }
+        // Backpressure: the writer still owns the other buffer, drop
+        // this one rather than block acquisition on the disk
+        pthread_mutex_lock(&writer->lock);
+        writer->stats.batches_dropped++;
+        writer->stats.samples_dropped += buffer->count;
+        pthread_mutex_unlock(&writer->lock);
+        buffer->count = 0;
+        return false;
+    }
+
+    if (timer_expired(writer)) {
+        (void)swap_buffers(writer, true);  // Busy writer: keep filling
+    }
+    return true;
+}
+
+void telemetry_async_poll(TelemetryAsyncWriter *writer) {
+    assert(writer != NULL && writer->running);
+
+    if (writer->buffers[writer->fill].count > 0 && timer_expired(writer)) {
+        (void)swap_buffers(writer, true);
+    }
+}
+
+bool telemetry_async_flush(TelemetryAsyncWriter *writer) {
+    assert(writer != NULL && writer->running);
+
+    wait_idle(writer);
+    if (writer->buffers[writer->fill].count > 0) {
+        bool swapped = swap_buffers(writer, false);
+        assert(swapped);  // Rule 7: the writer was idle
+        (void)swapped;
+        wait_idle(writer);
+    }
+
+    pthread_mutex_lock(&writer->lock);
+    bool ok = (writer->stats.write_errors == 0);
+    pthread_mutex_unlock(&writer->lock);
+    return ok;
+}
+
+bool telemetry_async_close(TelemetryAsyncWriter *writer) {
+    assert(writer != NULL && writer->running);
+
+    bool ok = telemetry_async_flush(writer);
+
+    pthread_mutex_lock(&writer->lock);
+    writer->stop = true;
+    pthread_cond_signal(&writer->work);
+    pthread_mutex_unlock(&writer->lock);
+    pthread_join(writer->thread, NULL);
+    writer->running = false;
+
+    pthread_cond_destroy(&writer->idle);
+    pthread_cond_destroy(&writer->work);
+    pthread_mutex_destroy(&writer->lock);
+
+    if (!telemetry_csv_close(&writer->csv)) {  // Rule 5
+        ok = false;
+    }
+    return ok;
+}
+
+void telemetry_async_get_stats(TelemetryAsyncWriter *writer, TelemetryAsyncStats *out) {
+    assert(writer != NULL && out != NULL);
+
+    if (!writer->running) {
+        *out = writer->stats;  // Closed: the thread is gone
+        return;
+    }
+    pthread_mutex_lock(&writer->lock);
+    *out = writer->stats;
+    pthread_mutex_unlock(&writer->lock);
+}
@@ -0,0 +1,87 @@
+/*
+ * TELEMETRY ASYNC WRITER - Double-buffered CSV logging on a writer thread
+ *
+ * The acquisition thread appends samples to one of two static buffers
+ * (a struct copy, no I/O). When that buffer is full, or
+ * TELEMETRY_ASYNC_FLUSH_MS after the last swap, the buffers swap and the
+ * writer thread formats the full one through telemetry_csv (64 KiB
+ * write() calls) while acquisition keeps filling the other.
+ *
+ * Backpressure: if the writer is still busy with the previous buffer
+ * when the next one fills, the full buffer is dropped and counted, so a
+ * disk stall never blocks ingestion. Only telemetry_async_flush() and
+ * telemetry_async_close() wait for the writer.
+ *
+ * One producer thread. Nothing is allocated after telemetry_async_open()
+ * (the thread stack is created once there).
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -I../../common -c telemetry_async_writer.c
+ */
+
+#ifndef TELEMETRY_ASYNC_WRITER_H
+#define TELEMETRY_ASYNC_WRITER_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "clock_source.h"
+#include "telemetry_csv.h"
+#include "telemetry_types.h"
+
+#define TELEMETRY_ASYNC_BATCH 4096     /* Samples per buffer (Rule 3: fixed) */
+#define TELEMETRY_ASYNC_FLUSH_MS 100   /* Swap a partial buffer after this */
+
+typedef struct {
+    TelemetryData samples[TELEMETRY_ASYNC_BATCH];
+    size_t count;
+} TelemetryAsyncBuffer;
+
+typedef struct {
+    uint64_t samples_written;
+    uint64_t batches_written;
+    uint64_t samples_dropped;
+    uint64_t batches_dropped;   /* Buffer full while the writer was busy */
+    uint64_t timed_swaps;       /* Partial buffers handed over by the timer */
+    uint64_t write_errors;
+} TelemetryAsyncStats;
+
+typedef struct {
+    TelemetryAsyncBuffer buffers[2];
+    size_t fill;            /* Buffer the producer appends to */
+    uint64_t last_swap_ns;  /* Producer side, for the flush timer */
+    ClockSource clock;      /* Coarse: the timer needs ms, not ns */
+
+    /* Shared with the writer thread, guarded by lock */
+    pthread_mutex_t lock;
+    pthread_cond_t work;    /* Signalled on swap and on stop */
+    pthread_cond_t idle;    /* Signalled when a buffer was written */
+    bool pending;           /* buffers[1 - fill] waits for the writer */
+    bool stop;
+    TelemetryAsyncStats stats;
+
+    pthread_t thread;
+    bool running;
+    TelemetryCsvWriter csv;  /* Writer thread only */
+} TelemetryAsyncWriter;
+
+/* Create/truncate filename and start the writer thread */
+bool telemetry_async_open(TelemetryAsyncWriter *writer, const char *filename);
+
+/* Queue one sample; false if a full buffer had to be dropped */
+bool telemetry_async_append(TelemetryAsyncWriter *writer, const TelemetryData *sample);
+
+/* Swap a partial buffer if the flush timer expired (for idle producers) */
+void telemetry_async_poll(TelemetryAsyncWriter *writer);
+
+/* Hand over everything appended so far and wait until it is written */
+bool telemetry_async_flush(TelemetryAsyncWriter *writer);
+
+/* Flush, stop the thread and close; false if any write failed */
+bool telemetry_async_close(TelemetryAsyncWriter *writer);
+
+/* Consistent copy of the counters (also valid after close) */
+void telemetry_async_get_stats(TelemetryAsyncWriter *writer, TelemetryAsyncStats *out);
+
+#endif /* TELEMETRY_ASYNC_WRITER_H */
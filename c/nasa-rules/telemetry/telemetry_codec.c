@@ -0,0 +1,515 @@
+/*
+ * TELEMETRY CODEC - Implementation
+ */
+
+#include "telemetry_codec.h"
+
+#include <assert.h>
+#include <string.h>
+
+#define BLOCK_MAGIC 0x424D4C54u  // "TLMB" read as little-endian u32
+#define BLOCK_VERSION 1
+#define VARINT_MAX_BYTES 10
+
+// ============================================
+// BYTE / BIT / VARINT HELPERS
+// ============================================
+
+static void put_u16(uint8_t *out, uint16_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(uint8_t *out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static uint16_t get_u16(const uint8_t *in) {
+    return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *in) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; i--) {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+static uint64_t zigzag_encode(int64_t value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static int64_t zigzag_decode(uint64_t value) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+static size_t varint_write(uint8_t *out, uint64_t value) {
+    size_t n = 0;
+    while (value >= 0x80 && n < VARINT_MAX_BYTES - 1) {
+        out[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+}
+
+static bool varint_read(const uint8_t *in, size_t size, size_t *offset, uint64_t *value) {
+    uint64_t result = 0;
+    for (unsigned i = 0; i < VARINT_MAX_BYTES && *offset < size; i++) {
+        uint8_t byte = in[(*offset)++];
+        result |= (uint64_t)(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;  // Truncated or overlong
+}
+
+static void bits_init(BitWriter *w, uint8_t *data, size_t capacity) {
+    *w = (BitWriter){ data, capacity, 0, 0, 0 };
+}
+
+/* Append the low `count` bits of value, MSB first (count <= 32) */
+static void bits_put32(BitWriter *w, uint64_t value, unsigned count) {
+    assert(count <= 32);
+    if (count == 0) {
+        return;
+    }
+    w->pending = (w->pending << count) | (value & ((UINT64_C(1) << count) - 1));
+    w->pending_bits += count;
+    while (w->pending_bits >= 8) {
+        assert(w->bytes < w->capacity);
+        w->pending_bits -= 8;
+        w->data[w->bytes++] = (uint8_t)(w->pending >> w->pending_bits);
+    }
+}
+
+static void bits_put(BitWriter *w, uint64_t value, unsigned count) {
+    if (count > 32) {
+        bits_put32(w, value >> 32, count - 32);
+        count = 32;
+    }
+    bits_put32(w, value, count);
+}
+
+static size_t bits_flush(BitWriter *w) {
+    if (w->pending_bits > 0) {
+        assert(w->bytes < w->capacity);
+        w->data[w->bytes++] = (uint8_t)(w->pending << (8 - w->pending_bits));
+        w->pending_bits = 0;
+    }
+    return w->bytes;
+}
+
+static bool bits_get32(BitReader *r, unsigned count, uint64_t *value) {
+    assert(count <= 32);
+    if (r->bit_offset + count > r->size * 8) {
+        return false;
+    }
+    if (count == 0) {
+        *value = 0;
+        return true;
+    }
+
+    size_t byte = r->bit_offset / 8;
+    unsigned skip = (unsigned)(r->bit_offset % 8);
+    uint64_t window = 0;
+    if (byte + 8 <= r->size) {
+        // Fast path: one big-endian 64-bit window covers skip + 32 bits
+        for (int i = 0; i < 8; i++) {
+            window = (window << 8) | r->data[byte + (size_t)i];
+        }
+    } else {
+        for (int i = 0; i < 8; i++) {
+            uint8_t b = (byte + (size_t)i < r->size) ? r->data[byte + (size_t)i] : 0;
+            window = (window << 8) | b;
+        }
+    }
+
+    *value = (window << skip) >> (64 - count);
+    r->bit_offset += count;
+    return true;
+}
+
+static bool bits_get(BitReader *r, unsigned count, uint64_t *value) {
+    uint64_t high = 0;
+    if (count > 32) {
+        if (!bits_get32(r, count - 32, &high)) {
+            return false;
+        }
+        count = 32;
+    }
+    uint64_t low = 0;
+    if (!bits_get32(r, count, &low)) {
+        return false;
+    }
+    *value = (high << 32) | low;
+    return true;
+}
+
+static uint64_t double_bits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static double bits_double(uint64_t bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// ============================================
+// ENCODER
+// ============================================
+
+void telemetry_encoder_reset(TelemetryEncoder *encoder) {
+    assert(encoder != NULL);
+
+    encoder->dictionary_count = 0;
+    encoder->timestamp_bytes = 0;
+    encoder->count = 0;
+    encoder->previous_timestamp = 0;
+    encoder->previous_delta = 0;
+    memset(encoder->temperature_state, 0, sizeof(encoder->temperature_state));
+    bits_init(&encoder->temperature_bits, encoder->temperatures,
+              sizeof(encoder->temperatures));
+}
+
+size_t telemetry_encoder_count(const TelemetryEncoder *encoder) {
+    assert(encoder != NULL);
+    return encoder->count;
+}
+
+/* Dictionary index of id, adding it if new; -1 when the dictionary is full */
+static int dictionary_index(TelemetryEncoder *encoder, int id) {
+    if (encoder->count > 0) {
+        // Fast path: consecutive samples from the same sensor
+        int last = encoder->sensor_indexes[encoder->count - 1];
+        if (encoder->dictionary[last] == id) {
+            return last;
+        }
+    }
+    for (size_t i = 0; i < encoder->dictionary_count; i++) {
+        if (encoder->dictionary[i] == id) {
+            return (int)i;
+        }
+    }
+    if (encoder->dictionary_count >= TELEMETRY_BLOCK_MAX_SENSORS) {
+        return -1;
+    }
+    encoder->dictionary[encoder->dictionary_count] = id;
+    return (int)encoder->dictionary_count++;
+}
+
+static void encode_timestamp(TelemetryEncoder *encoder, uint64_t timestamp) {
+    uint8_t *out = &encoder->timestamps[encoder->timestamp_bytes];
+    if (encoder->count == 0) {
+        encoder->timestamp_bytes += varint_write(out, timestamp);
+    } else {
+        int64_t delta = (int64_t)(timestamp - encoder->previous_timestamp);
+        int64_t value = (encoder->count == 1) ? delta : delta - encoder->previous_delta;
+        encoder->timestamp_bytes += varint_write(out, zigzag_encode(value));
+        encoder->previous_delta = delta;
+    }
+    encoder->previous_timestamp = timestamp;
+}
+
+static void encode_temperature(BitWriter *w, GorillaState *state, double temperature) {
+    uint64_t bits = double_bits(temperature);
+
+    if (!state->has_value) {
+        bits_put(w, bits, 64);  // First sample of this sensor: raw value
+        state->previous_bits = bits;
+        state->has_value = true;
+        return;
+    }
+
+    uint64_t x = bits ^ state->previous_bits;
+    state->previous_bits = bits;
+    if (x == 0) {
+        bits_put(w, 0, 1);  // '0': same value
+        return;
+    }
+
+    unsigned leading = (unsigned)__builtin_clzll(x);
+    unsigned trailing = (unsigned)__builtin_ctzll(x);
+    leading = (leading > 31) ? 31 : leading;  // 5-bit field
+
+    if (state->has_window && leading >= state->leading && trailing >= state->trailing) {
+        // '10': meaningful bits fit in the previous window
+        unsigned width = 64u - state->leading - state->trailing;
+        bits_put(w, 2, 2);
+        bits_put(w, x >> state->trailing, width);
+        return;
+    }
+
+    // '11' + 5-bit leading + 6-bit width (64 stored as 0) + bits
+    unsigned width = 64 - leading - trailing;
+    bits_put(w, 3, 2);
+    bits_put(w, leading, 5);
+    bits_put(w, width & 0x3F, 6);
+    bits_put(w, x >> trailing, width);
+    state->leading = (uint8_t)leading;
+    state->trailing = (uint8_t)trailing;
+    state->has_window = true;
+}
+
+bool telemetry_encoder_add(TelemetryEncoder *encoder, const TelemetryData *sample) {
+    assert(encoder != NULL);
+    assert(sample != NULL);
+
+    if (encoder->count >= TELEMETRY_BLOCK_SAMPLES) {
+        return false;
+    }
+    int index = dictionary_index(encoder, sample->sensor_id);
+    if (index < 0) {
+        return false;
+    }
+
+    encode_timestamp(encoder, sample->timestamp);
+    encode_temperature(&encoder->temperature_bits,
+                       &encoder->temperature_state[index], sample->temperature);
+    encoder->sensor_indexes[encoder->count] = (uint8_t)index;
+    encoder->count++;
+    return true;
+}
+
+static unsigned index_width(size_t dictionary_count) {
+    unsigned bits = 0;
+    while (bits < 8 && ((size_t)1 << bits) < dictionary_count) {
+        bits++;
+    }
+    return bits;
+}
+
+size_t telemetry_encoder_size_bound(const TelemetryEncoder *encoder) {
+    assert(encoder != NULL);
+
+    const BitWriter *temps = &encoder->temperature_bits;
+    return TELEMETRY_BLOCK_HEADER_SIZE
+           + 5 * encoder->dictionary_count      // Zigzag varints of int ids
+           + encoder->count                     // At most 8 bits per index
+           + encoder->timestamp_bytes
+           + temps->bytes + (temps->pending_bits + 7) / 8;
+}
+
+size_t telemetry_encoder_finish(TelemetryEncoder *encoder, uint8_t *out, size_t capacity) {
+    assert(encoder != NULL);
+    assert(out != NULL);
+
+    if (capacity < TELEMETRY_BLOCK_MAX_BYTES) {
+        return 0;  // Worst case must fit; blocks are never truncated
+    }
+
+    uint8_t *cursor = out + TELEMETRY_BLOCK_HEADER_SIZE;
+
+    size_t dict_bytes = 0;
+    for (size_t i = 0; i < encoder->dictionary_count; i++) {
+        dict_bytes += varint_write(cursor + dict_bytes, zigzag_encode(encoder->dictionary[i]));
+    }
+    cursor += dict_bytes;
+
+    unsigned width = index_width(encoder->dictionary_count);
+    BitWriter sensors;
+    bits_init(&sensors, cursor, TELEMETRY_BLOCK_SAMPLES);
+    for (size_t i = 0; i < encoder->count; i++) {
+        bits_put(&sensors, encoder->sensor_indexes[i], width);
+    }
+    size_t sensor_bytes = bits_flush(&sensors);
+    cursor += sensor_bytes;
+
+    memcpy(cursor, encoder->timestamps, encoder->timestamp_bytes);
+    cursor += encoder->timestamp_bytes;
+
+    size_t temp_bytes = bits_flush(&encoder->temperature_bits);
+    memcpy(cursor, encoder->temperatures, temp_bytes);
+    cursor += temp_bytes;
+
+    put_u32(&out[0], BLOCK_MAGIC);
+    out[4] = BLOCK_VERSION;
+    out[5] = (uint8_t)width;
+    put_u16(&out[6], (uint16_t)encoder->count);
+    put_u16(&out[8], (uint16_t)encoder->dictionary_count);
+    put_u16(&out[10], 0);
+    put_u32(&out[12], (uint32_t)dict_bytes);
+    put_u32(&out[16], (uint32_t)sensor_bytes);
+    put_u32(&out[20], (uint32_t)encoder->timestamp_bytes);
+    put_u32(&out[24], (uint32_t)temp_bytes);
+
+    return (size_t)(cursor - out);
+}
+
+// ============================================
+// DECODER
+// ============================================
+
+static bool decode_dictionary(TelemetryDecoder *decoder, const uint8_t *data, size_t size) {
+    size_t offset = 0;
+    for (size_t i = 0; i < decoder->dictionary_count; i++) {
+        uint64_t raw = 0;
+        if (!varint_read(data, size, &offset, &raw)) {
+            return false;
+        }
+        decoder->dictionary[i] = (int)zigzag_decode(raw);
+    }
+    return offset == size;
+}
+
+bool telemetry_decoder_open(TelemetryDecoder *decoder, const uint8_t *data, size_t size) {
+    assert(decoder != NULL);
+
+    if (data == NULL || size < TELEMETRY_BLOCK_HEADER_SIZE) {
+        return false;
+    }
+    if (get_u32(&data[0]) != BLOCK_MAGIC || data[4] != BLOCK_VERSION) {
+        return false;
+    }
+
+    decoder->index_bits = data[5];
+    decoder->count = get_u16(&data[6]);
+    decoder->dictionary_count = get_u16(&data[8]);
+    const size_t dict_bytes = get_u32(&data[12]);
+    const size_t sensor_bytes = get_u32(&data[16]);
+    const size_t ts_bytes = get_u32(&data[20]);
+    const size_t temp_bytes = get_u32(&data[24]);
+
+    if (decoder->count > TELEMETRY_BLOCK_SAMPLES
+        || decoder->dictionary_count > TELEMETRY_BLOCK_MAX_SENSORS
+        || decoder->index_bits > 8
+        || (decoder->count > 0 && decoder->dictionary_count == 0)) {
+        return false;
+    }
+    // Each column is bounded by its worst case, so the sum cannot overflow
+    if (dict_bytes > TELEMETRY_DICT_MAX || sensor_bytes > TELEMETRY_BLOCK_SAMPLES
+        || ts_bytes > TELEMETRY_TS_COLUMN_MAX || temp_bytes > TELEMETRY_TEMP_COLUMN_MAX) {
+        return false;
+    }
+    decoder->block_size = TELEMETRY_BLOCK_HEADER_SIZE + dict_bytes + sensor_bytes
+                          + ts_bytes + temp_bytes;
+    if (decoder->block_size > size) {
+        return false;
+    }
+
+    const uint8_t *cursor = data + TELEMETRY_BLOCK_HEADER_SIZE;
+    if (!decode_dictionary(decoder, cursor, dict_bytes)) {
+        return false;
+    }
+    cursor += dict_bytes;
+
+    decoder->sensors = (BitReader){ cursor, sensor_bytes, 0 };
+    cursor += sensor_bytes;
+    decoder->timestamps = cursor;
+    decoder->timestamps_size = ts_bytes;
+    decoder->timestamp_offset = 0;
+    cursor += ts_bytes;
+    decoder->temperatures = (BitReader){ cursor, temp_bytes, 0 };
+
+    decoder->position = 0;
+    decoder->previous_timestamp = 0;
+    decoder->previous_delta = 0;
+    memset(decoder->temperature_state, 0, sizeof(decoder->temperature_state));
+    return true;
+}
+
+static bool decode_timestamp(TelemetryDecoder *decoder, uint64_t *timestamp) {
+    uint64_t raw = 0;
+    if (!varint_read(decoder->timestamps, decoder->timestamps_size,
+                     &decoder->timestamp_offset, &raw)) {
+        return false;
+    }
+
+    if (decoder->position == 0) {
+        *timestamp = raw;
+    } else {
+        int64_t value = zigzag_decode(raw);
+        int64_t delta = (decoder->position == 1) ? value : decoder->previous_delta + value;
+        *timestamp = decoder->previous_timestamp + (uint64_t)delta;
+        decoder->previous_delta = delta;
+    }
+    decoder->previous_timestamp = *timestamp;
+    return true;
+}
+
+static bool decode_temperature(BitReader *r, GorillaState *state, double *temperature) {
+    uint64_t control = 0;
+
+    if (!state->has_value) {
+        if (!bits_get(r, 64, &state->previous_bits)) {
+            return false;
+        }
+        state->has_value = true;
+    } else if (!bits_get(r, 1, &control)) {
+        return false;
+    } else if (control == 1) {
+        uint64_t window_flag = 0;
+        if (!bits_get(r, 1, &window_flag)) {
+            return false;
+        }
+        if (window_flag == 1) {
+            uint64_t leading = 0;
+            uint64_t width = 0;
+            if (!bits_get(r, 5, &leading) || !bits_get(r, 6, &width)) {
+                return false;
+            }
+            width = (width == 0) ? 64 : width;
+            if (leading + width > 64) {
+                return false;
+            }
+            state->leading = (uint8_t)leading;
+            state->trailing = (uint8_t)(64 - leading - width);
+            state->has_window = true;
+        } else if (!state->has_window) {
+            return false;  // Reuse of a window that was never sent
+        }
+
+        uint64_t x = 0;
+        if (!bits_get(r, 64u - state->leading - state->trailing, &x)) {
+            return false;
+        }
+        state->previous_bits ^= x << state->trailing;
+    }
+
+    *temperature = bits_double(state->previous_bits);
+    return true;
+}
+
+bool telemetry_decoder_next(TelemetryDecoder *decoder, TelemetryData *sample) {
+    assert(decoder != NULL);
+    assert(sample != NULL);
+
+    if (decoder->position >= decoder->count) {
+        return false;
+    }
+
+    uint64_t index = 0;
+    if (!bits_get(&decoder->sensors, decoder->index_bits, &index)
+        || index >= decoder->dictionary_count) {
+        return false;
+    }
+
+    uint64_t timestamp = 0;
+    double temperature = 0.0;
+    if (!decode_timestamp(decoder, &timestamp)
+        || !decode_temperature(&decoder->temperatures,
+                               &decoder->temperature_state[index], &temperature)) {
+        return false;
+    }
+
+    sample->sensor_id = decoder->dictionary[index];
+    sample->temperature = temperature;
+    sample->timestamp = (uint32_t)timestamp;
+    sample->valid = true;
+    sample->time_ns = 0;  // Not stored
+    decoder->position++;
+    return true;
+}
+
+size_t telemetry_decoder_block_size(const TelemetryDecoder *decoder) {
+    assert(decoder != NULL);
+    return decoder->block_size;
+}
@@ -0,0 +1,148 @@
+/*
+ * TELEMETRY CODEC - Compressed binary columnar blocks
+ *
+ * A block holds up to TELEMETRY_BLOCK_SAMPLES samples stored column by
+ * column, each column with the encoding that suits it:
+ *
+ *   sensor_id    dictionary of distinct ids + bit-packed dictionary
+ *                indexes (0 bits per sample when one sensor is present)
+ *   timestamp    first value, first delta, then delta-of-delta; all as
+ *                zigzag LEB128 varints (1 byte per sample at a steady rate)
+ *   temperature  Gorilla XOR compression against the previous value of
+ *                the same sensor (interleaved sensors do not break runs)
+ *
+ * Block layout (little-endian):
+ *
+ *   offset  size  field
+ *   0       4     magic "TLMB"
+ *   4       1     version (1)
+ *   5       1     bits per sensor index
+ *   6       2     sample count
+ *   8       2     dictionary entries
+ *   10      2     reserved (0)
+ *   12      4     dictionary bytes
+ *   16      4     sensor column bytes
+ *   20      4     timestamp column bytes
+ *   24      4     temperature column bytes
+ *   28      ...   dictionary | sensors | timestamps | temperatures
+ *
+ * Only the sensor_id, temperature and timestamp fields are stored;
+ * decoded samples come back with valid = true and time_ns = 0.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c telemetry_codec.c
+ */
+
+#ifndef TELEMETRY_CODEC_H
+#define TELEMETRY_CODEC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "telemetry_types.h"
+
+#define TELEMETRY_BLOCK_SAMPLES 1024
+#define TELEMETRY_BLOCK_MAX_SENSORS 256
+#define TELEMETRY_BLOCK_HEADER_SIZE 28
+
+/* Worst case per sample: 10-byte varint, 77-bit Gorilla record, 1 index byte */
+#define TELEMETRY_TS_COLUMN_MAX (10 * (TELEMETRY_BLOCK_SAMPLES + 2))
+#define TELEMETRY_TEMP_COLUMN_MAX (10 * TELEMETRY_BLOCK_SAMPLES + 8)
+#define TELEMETRY_DICT_MAX (5 * TELEMETRY_BLOCK_MAX_SENSORS)
+
+/* Most one sample can add to a block: varint + Gorilla record + index + new dictionary entry */
+#define TELEMETRY_SAMPLE_MAX_BYTES (10 + 10 + 1 + 5)
+
+/* Buffer size that always fits one finished block */
+#define TELEMETRY_BLOCK_MAX_BYTES (TELEMETRY_BLOCK_HEADER_SIZE + TELEMETRY_DICT_MAX \
+                                   + TELEMETRY_BLOCK_SAMPLES                        \
+                                   + TELEMETRY_TS_COLUMN_MAX                        \
+                                   + TELEMETRY_TEMP_COLUMN_MAX)
+
+typedef struct {
+    uint8_t *data;
+    size_t capacity;
+    size_t bytes;      /* Complete bytes written */
+    uint64_t pending;  /* Bits not yet flushed, MSB first */
+    unsigned pending_bits;
+} BitWriter;
+
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    size_t bit_offset;
+} BitReader;
+
+/* Per-sensor XOR state, reset at the start of every block */
+typedef struct {
+    uint64_t previous_bits;  /* Previous temperature as raw IEEE-754 */
+    uint8_t leading;         /* Current meaningful-bit window */
+    uint8_t trailing;
+    bool has_value;
+    bool has_window;
+} GorillaState;
+
+typedef struct {
+    /* Dictionary: distinct sensor ids in first-seen order */
+    int dictionary[TELEMETRY_BLOCK_MAX_SENSORS];
+    size_t dictionary_count;
+
+    /* Column buffers, concatenated by telemetry_encoder_finish */
+    uint8_t sensor_indexes[TELEMETRY_BLOCK_SAMPLES];
+    uint8_t timestamps[TELEMETRY_TS_COLUMN_MAX];
+    uint8_t temperatures[TELEMETRY_TEMP_COLUMN_MAX];
+    size_t timestamp_bytes;
+    BitWriter temperature_bits;
+
+    size_t count;
+    uint64_t previous_timestamp;
+    int64_t previous_delta;
+    GorillaState temperature_state[TELEMETRY_BLOCK_MAX_SENSORS];
+} TelemetryEncoder;
+
+typedef struct {
+    int dictionary[TELEMETRY_BLOCK_MAX_SENSORS];
+    size_t dictionary_count;
+    unsigned index_bits;
+
+    BitReader sensors;
+    const uint8_t *timestamps;
+    size_t timestamps_size;
+    size_t timestamp_offset;
+    BitReader temperatures;
+
+    size_t count;
+    size_t position;
+    size_t block_size;
+    uint64_t previous_timestamp;
+    int64_t previous_delta;
+    GorillaState temperature_state[TELEMETRY_BLOCK_MAX_SENSORS];
+} TelemetryDecoder;
+
+/* Start an empty block */
+void telemetry_encoder_reset(TelemetryEncoder *encoder);
+
+/* Append a sample. Returns false when the block is full (sample count
+ * or dictionary); finish the block, reset and add the sample again. */
+bool telemetry_encoder_add(TelemetryEncoder *encoder, const TelemetryData *sample);
+
+/* Number of samples in the pending block */
+size_t telemetry_encoder_count(const TelemetryEncoder *encoder);
+
+/* Upper bound of the size telemetry_encoder_finish would return now */
+size_t telemetry_encoder_size_bound(const TelemetryEncoder *encoder);
+
+/* Serialize the block into out; returns its size, 0 if capacity is short.
+ * TELEMETRY_BLOCK_MAX_BYTES is always enough. */
+size_t telemetry_encoder_finish(TelemetryEncoder *encoder, uint8_t *out, size_t capacity);
+
+/* Validate the header and column sizes of the block at data */
+bool telemetry_decoder_open(TelemetryDecoder *decoder, const uint8_t *data, size_t size);
+
+/* Decode the next sample; false when the block is exhausted or corrupt */
+bool telemetry_decoder_next(TelemetryDecoder *decoder, TelemetryData *sample);
+
+/* Total bytes of the opened block, to step to the next one in a stream */
+size_t telemetry_decoder_block_size(const TelemetryDecoder *decoder);
+
+#endif /* TELEMETRY_CODEC_H */
@@ -0,0 +1,174 @@
+/*
+ * TELEMETRY CSV - Implementation
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "telemetry_csv.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_WRITE_RETRIES 1000  // Rule 2: bound partial-write loops
+
+/* Exact below this magnitude: the mantissa times 100 fits in 64 bits */
+#define FIXED2_EXACT_LIMIT 9007199254740992.0  // 2^53
+
+// ============================================
+// NUMBER FORMATTING
+// ============================================
+
+/* Write the decimal digits of value; returns the number of chars */
+static size_t format_u64(char *out, uint64_t value) {
+    char digits[20];
+    size_t n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    for (size_t i = 0; i < n; i++) {
+        out[i] = digits[n - 1 - i];
+    }
+    return n;
+}
+
+static size_t format_i32(char *out, int value) {
+    if (value < 0) {
+        out[0] = '-';
+        // Negate in 64 bits so INT_MIN is safe
+        return 1 + format_u64(out + 1, (uint64_t)(-(int64_t)value));
+    }
+    return format_u64(out, (uint64_t)value);
+}
+
+/* round(|x| * 100) half-to-even on the exact binary value of x */
+static uint64_t scaled_hundredths(double magnitude) {
+    int exponent = 0;
+    double fraction = frexp(magnitude, &exponent);   // magnitude = f * 2^e
+    uint64_t mantissa = (uint64_t)ldexp(fraction, 53);
+    int shift = 53 - exponent;                       // magnitude = m / 2^shift
+
+    if (shift <= 0) {
+        return (mantissa << -shift) * 100;           // Integer value
+    }
+
+    uint64_t product = mantissa * 100;               // < 2^60, exact
+    if (shift >= 64) {
+        return 0;                                    // Below 1/2 hundredth
+    }
+
+    uint64_t quotient = product >> shift;
+    uint64_t remainder = product & ((UINT64_C(1) << shift) - 1);
+    uint64_t half = UINT64_C(1) << (shift - 1);
+    if (remainder > half || (remainder == half && (quotient & 1) != 0)) {
+        quotient++;
+    }
+    return quotient;
+}
+
+/* Same output as printf("%.2f", value) */
+static size_t format_fixed2(char *out, double value, size_t out_size) {
+    if (!isfinite(value) || fabs(value) >= FIXED2_EXACT_LIMIT) {
+        int n = snprintf(out, out_size, "%.2f", value);
+        return (n > 0) ? (size_t)n : 0;
+    }
+
+    size_t len = 0;
+    if (signbit(value)) {
+        out[len++] = '-';  // printf keeps the sign of -0.00
+    }
+
+    uint64_t hundredths = scaled_hundredths(fabs(value));
+    len += format_u64(out + len, hundredths / 100);
+    out[len++] = '.';
+    out[len++] = (char)('0' + (hundredths / 10) % 10);
+    out[len++] = (char)('0' + hundredths % 10);
+    return len;
+}
+
+size_t telemetry_csv_format_line(char *out, int sensor_id,
+                                 double temperature, uint32_t timestamp) {
+    assert(out != NULL);
+
+    size_t len = format_i32(out, sensor_id);
+    out[len++] = ',';
+    len += format_fixed2(out + len, temperature, TELEMETRY_CSV_MAX_LINE - len);
+    out[len++] = ',';
+    len += format_u64(out + len, timestamp);
+    out[len++] = '\n';
+
+    assert(len <= TELEMETRY_CSV_MAX_LINE);
+    return len;
+}
+
+// ============================================
+// BUFFERED OUTPUT
+// ============================================
+
+static bool write_all(int fd, const char *data, size_t size) {
+    size_t written = 0;
+    for (int attempt = 0; attempt < MAX_WRITE_RETRIES && written < size; attempt++) {
+        ssize_t n = write(fd, data + written, size - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        written += (size_t)n;
+    }
+    return written == size;
+}
+
+bool telemetry_csv_open(TelemetryCsvWriter *writer, const char *filename) {
+    assert(writer != NULL);
+    assert(filename != NULL);
+
+    writer->used = 0;
+    writer->failed = false;
+    writer->fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    return writer->fd >= 0;
+}
+
+bool telemetry_csv_flush(TelemetryCsvWriter *writer) {
+    assert(writer != NULL);
+
+    if (!writer->failed && writer->used > 0) {
+        writer->failed = !write_all(writer->fd, writer->buffer, writer->used);
+    }
+    writer->used = 0;
+    return !writer->failed;
+}
+
+bool telemetry_csv_write(TelemetryCsvWriter *writer, int sensor_id,
+                         double temperature, uint32_t timestamp) {
+    assert(writer != NULL);
+    assert(writer->fd >= 0);
+
+    if (TELEMETRY_CSV_BUFFER_SIZE - writer->used < TELEMETRY_CSV_MAX_LINE) {
+        if (!telemetry_csv_flush(writer)) {
+            return false;
+        }
+    }
+
+    writer->used += telemetry_csv_format_line(&writer->buffer[writer->used],
+                                              sensor_id, temperature, timestamp);
+    return !writer->failed;
+}
+
+bool telemetry_csv_close(TelemetryCsvWriter *writer) {
+    assert(writer != NULL);
+
+    bool ok = telemetry_csv_flush(writer);
+    if (close(writer->fd) != 0) {  // Rule 5: Check close
+        ok = false;
+    }
+    writer->fd = -1;
+    return ok;
+}
@@ -0,0 +1,53 @@
+/*
+ * TELEMETRY CSV - Buffered writer with hand-written number formatting
+ *
+ * Produces exactly the bytes of fprintf(file, "%d,%.2f,%u\n", ...) but
+ * formats integers and fixed two-decimal doubles with integer routines
+ * (no locale, no stdio locking) into one large buffer that is flushed
+ * with a few write() calls.
+ *
+ * %.2f is reproduced exactly: the double is split into its integer
+ * mantissa and binary exponent and rounded half-to-even on the exact
+ * value, as glibc does. Values with |x| >= 2^53 (or non-finite) fall
+ * back to snprintf.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c telemetry_csv.c
+ */
+
+#ifndef TELEMETRY_CSV_H
+#define TELEMETRY_CSV_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TELEMETRY_CSV_BUFFER_SIZE (64 * 1024)
+
+/* Longest line: "%d" (11) + "%.2f" of DBL_MAX (313) + "%u" (10) + 3 */
+#define TELEMETRY_CSV_MAX_LINE 340
+
+typedef struct {
+    char buffer[TELEMETRY_CSV_BUFFER_SIZE];
+    size_t used;
+    int fd;
+    bool failed;  /* Sticky: set by the first failed write() */
+} TelemetryCsvWriter;
+
+/* Truncate/create filename (mode 0666 & ~umask, like fopen "w") */
+bool telemetry_csv_open(TelemetryCsvWriter *writer, const char *filename);
+
+/* Append one "sensor_id,temperature,timestamp\n" line */
+bool telemetry_csv_write(TelemetryCsvWriter *writer, int sensor_id,
+                         double temperature, uint32_t timestamp);
+
+/* Write out everything buffered so far */
+bool telemetry_csv_flush(TelemetryCsvWriter *writer);
+
+/* Flush and close; returns false if any write or the close failed */
+bool telemetry_csv_close(TelemetryCsvWriter *writer);
+
+/* Format one line into out[TELEMETRY_CSV_MAX_LINE]; returns its length */
+size_t telemetry_csv_format_line(char *out, int sensor_id,
+                                 double temperature, uint32_t timestamp);
+
+#endif /* TELEMETRY_CSV_H */
@@ -0,0 +1,174 @@
+/*
+ * TELEMETRY DOWNSAMPLE - Implementation
+ */
+
+#include "telemetry_downsample.h"
+
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+// ============================================
+// BUCKETS
+// ============================================
+
+static double x_of(const DownsamplePoint *point) {
+    return (double)point->sample.timestamp;
+}
+
+static double y_of(const DownsamplePoint *point) {
+    return point->sample.temperature;
+}
+
+static void bucket_start(DownsampleBucket *bucket, uint64_t index, const DownsamplePoint *point) {
+    bucket->first = *point;
+    bucket->min = *point;
+    bucket->max = *point;
+    bucket->last = *point;
+    bucket->sum_x = x_of(point);
+    bucket->sum_y = y_of(point);
+    bucket->index = index;
+    bucket->count = 1;
+}
+
+static void bucket_add(DownsampleBucket *bucket, const DownsamplePoint *point) {
+    if (y_of(point) < y_of(&bucket->min)) {
+        bucket->min = *point;
+    }
+    if (y_of(point) > y_of(&bucket->max)) {
+        bucket->max = *point;
+    }
+    bucket->last = *point;
+    bucket->sum_x += x_of(point);
+    bucket->sum_y += y_of(point);
+    bucket->count++;
+}
+
+// ============================================
+// SELECTION
+// ============================================
+
+/* MINMAX: the bucket's min and max, in stream order */
+static size_t emit_min_max(const DownsampleBucket *bucket, TelemetryData *out, size_t n) {
+    const DownsamplePoint *early = &bucket->min;
+    const DownsamplePoint *late = &bucket->max;
+    if (early->seq > late->seq) {
+        early = &bucket->max;
+        late = &bucket->min;
+    }
+    out[n++] = early->sample;
+    if (late->seq != early->seq) {
+        out[n++] = late->sample;
+    }
+    return n;
+}
+
+/* LTTB: the candidate of bucket forming the largest triangle with the
+ * anchor and (next_x, next_y); returned unless it is the anchor itself */
+static size_t emit_largest_triangle(TelemetryDownsampler *ds, const DownsampleBucket *bucket,
+                                    double next_x, double next_y, TelemetryData *out, size_t n) {
+    const DownsamplePoint *candidates[4] = {&bucket->first, &bucket->min, &bucket->max,
+                                            &bucket->last};
+    double ax = x_of(&ds->anchor);
+    double ay = y_of(&ds->anchor);
+
+    const DownsamplePoint *best = candidates[0];
+    double best_area = -1.0;
+    for (size_t c = 0; c < 4; c++) {
+        double px = x_of(candidates[c]);
+        double py = y_of(candidates[c]);
+        double area = fabs((ax - next_x) * (py - ay) - (ax - px) * (next_y - ay));  // 2x area
+        if (area > best_area) {
+            best_area = area;
+            best = candidates[c];
+        }
+    }
+
+    if (best->seq != ds->anchor.seq) {
+        out[n++] = best->sample;
+        ds->anchor = *best;
+    }
+    return n;
+}
+
+/* The current bucket is complete */
+static size_t close_current(TelemetryDownsampler *ds, TelemetryData *out, size_t n) {
+    if (ds->mode == TELEMETRY_DOWNSAMPLE_MINMAX) {
+        n = emit_min_max(&ds->current, out, n);
+    } else {
+        // The pending choice needed exactly this: the next bucket's average
+        if (ds->pending.count > 0) {
+            double count = (double)ds->current.count;
+            n = emit_largest_triangle(ds, &ds->pending, ds->current.sum_x / count,
+                                      ds->current.sum_y / count, out, n);
+        }
+        ds->pending = ds->current;
+    }
+    ds->current.count = 0;
+    return n;
+}
+
+// ============================================
+// PUBLIC API
+// ============================================
+
+void telemetry_downsample_init(TelemetryDownsampler *ds, TelemetryDownsampleMode mode,
+                               uint32_t from, uint32_t to, size_t buckets) {
+    assert(ds != NULL && from < to && buckets > 0);  // Rule 7
+
+    memset(ds, 0, sizeof(*ds));
+    ds->mode = mode;
+    ds->from = from;
+    ds->to = to;
+    ds->buckets = buckets;
+}
+
+size_t telemetry_downsample_push(TelemetryDownsampler *ds, const TelemetryData *sample,
+                                 TelemetryData out[TELEMETRY_DOWNSAMPLE_MAX_EMIT]) {
+    assert(ds != NULL && sample != NULL && out != NULL);  // Rule 7
+
+    if (sample->timestamp < ds->from || sample->timestamp >= ds->to) {
+        return 0;
+    }
+    DownsamplePoint point = {*sample, ds->seq++};
+    uint64_t index = (uint64_t)(sample->timestamp - ds->from) * ds->buckets /
+                     (uint64_t)(ds->to - ds->from);
+
+    size_t n = 0;
+    if (ds->mode == TELEMETRY_DOWNSAMPLE_LTTB && !ds->has_anchor) {
+        out[n++] = *sample;  // LTTB always keeps the first sample
+        ds->anchor = point;
+        ds->has_anchor = true;
+    }
+
+    if (ds->current.count == 0) {
+        bucket_start(&ds->current, index, &point);
+    } else if (index > ds->current.index) {
+        n = close_current(ds, out, n);
+        bucket_start(&ds->current, index, &point);
+    } else {
+        bucket_add(&ds->current, &point);  // Same bucket, or late
+    }
+    return n;
+}
+
+size_t telemetry_downsample_finish(TelemetryDownsampler *ds,
+                                   TelemetryData out[TELEMETRY_DOWNSAMPLE_MAX_EMIT]) {
+    assert(ds != NULL && out != NULL);  // Rule 7
+
+    size_t n = 0;
+    if (ds->current.count > 0) {
+        n = close_current(ds, out, n);
+    }
+    if (ds->mode == TELEMETRY_DOWNSAMPLE_LTTB && ds->pending.count > 0) {
+        // Last bucket: nothing follows but the last sample, which is kept
+        DownsamplePoint last = ds->pending.last;
+        n = emit_largest_triangle(ds, &ds->pending, x_of(&last), y_of(&last), out, n);
+        if (last.seq != ds->anchor.seq) {
+            out[n++] = last.sample;
+            ds->anchor = last;
+        }
+        ds->pending.count = 0;
+    }
+    return n;
+}
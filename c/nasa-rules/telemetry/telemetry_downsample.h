@@ -0,0 +1,83 @@
+/*
+ * TELEMETRY DOWNSAMPLE - Streaming reduction of a range to plot points
+ *
+ * Reduces the samples of [from, to) to about as many points as a plot
+ * has pixels, in one pass and O(1) memory: samples are pushed in time
+ * order (ring reads, archive queries, ...) and finished points come
+ * back as soon as they are known. The range is split into `buckets`
+ * equal time slices; x is the timestamp, y the temperature.
+ *
+ *   MINMAX  the min and the max of each bucket, in time order: every
+ *           spike survives, 2 points per bucket
+ *   LTTB    Largest-Triangle-Three-Buckets: the first and last sample,
+ *           plus per bucket the point forming the largest triangle with
+ *           the previous choice and the next bucket's average. Streaming
+ *           keeps only the bucket's first/min/max/last as candidates
+ *           (the MinMaxLTTB preselection), so the choice is delayed by
+ *           one bucket and the state stays constant-size.
+ *
+ * Samples outside [from, to) are ignored; a sample older than the
+ * current bucket is counted in it. Samples sharing a second share x.
+ * The output is one series: push the samples of one sensor only.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c telemetry_downsample.c
+ */
+
+#ifndef TELEMETRY_DOWNSAMPLE_H
+#define TELEMETRY_DOWNSAMPLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "telemetry_types.h"
+
+#define TELEMETRY_DOWNSAMPLE_MAX_EMIT 4  /* Points one push or finish can return */
+
+typedef enum {
+    TELEMETRY_DOWNSAMPLE_MINMAX = 0,
+    TELEMETRY_DOWNSAMPLE_LTTB = 1
+} TelemetryDownsampleMode;
+
+typedef struct {
+    TelemetryData sample;
+    uint64_t seq;     /* Position in the stream, tells candidates apart */
+} DownsamplePoint;
+
+typedef struct {
+    DownsamplePoint first;
+    DownsamplePoint min;
+    DownsamplePoint max;
+    DownsamplePoint last;
+    double sum_x;
+    double sum_y;
+    uint64_t index;   /* Bucket number in the range */
+    uint32_t count;   /* 0: no bucket */
+} DownsampleBucket;
+
+typedef struct {
+    TelemetryDownsampleMode mode;
+    uint32_t from;
+    uint32_t to;
+    uint64_t buckets;
+    uint64_t seq;             /* Samples accepted */
+    DownsampleBucket current; /* Filling */
+    DownsampleBucket pending; /* LTTB: complete, choice waits for current */
+    DownsamplePoint anchor;   /* LTTB: last point returned */
+    bool has_anchor;
+} TelemetryDownsampler;
+
+/* Points for [from, to): MINMAX returns up to 2 * buckets, LTTB up to
+ * buckets + 2. Requires from < to and buckets > 0. */
+void telemetry_downsample_init(TelemetryDownsampler *ds, TelemetryDownsampleMode mode,
+                               uint32_t from, uint32_t to, size_t buckets);
+
+/* Feed one sample; returns the points it completed, written to out */
+size_t telemetry_downsample_push(TelemetryDownsampler *ds, const TelemetryData *sample,
+                                 TelemetryData out[TELEMETRY_DOWNSAMPLE_MAX_EMIT]);
+
+/* End of the stream: the remaining points */
+size_t telemetry_downsample_finish(TelemetryDownsampler *ds,
+                                   TelemetryData out[TELEMETRY_DOWNSAMPLE_MAX_EMIT]);
+
+#endif /* TELEMETRY_DOWNSAMPLE_H */
@@ -0,0 +1,253 @@
+/*
+ * TELEMETRY PERSIST - Implementation
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "telemetry_persist.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define PERSIST_MASK ((uint64_t)TELEMETRY_PERSIST_CAPACITY - 1)
+#define CHECK_SEED 0x54454C454D455452ull  /* "TELEMETR": all-zero slots never validate */
+
+_Static_assert((TELEMETRY_PERSIST_CAPACITY & (TELEMETRY_PERSIST_CAPACITY - 1)) == 0,
+               "TELEMETRY_PERSIST_CAPACITY must be a power of two");
+_Static_assert(TELEMETRY_PERSIST_COMMIT_EVERY < TELEMETRY_PERSIST_CAPACITY,
+               "a commit must happen before the ring laps its head");
+
+// ============================================
+// CHECKSUMS
+// ============================================
+
+/* Multiply-xorshift fold: detects torn and stale words, not an attacker */
+static inline uint64_t mix(uint64_t hash, uint64_t word) {
+    hash ^= word;
+    hash *= 0x9E3779B97F4A7C15ull;
+    return hash ^ (hash >> 29);
+}
+
+static uint64_t slot_check(uint64_t ticket, const uint64_t *words) {
+    uint64_t hash = mix(CHECK_SEED, ticket);
+    for (size_t w = 0; w < TELEMETRY_PERSIST_WORDS; w++) {
+        hash = mix(hash, words[w]);
+    }
+    return hash;
+}
+
+static uint64_t header_check(const TelemetryPersistHeader *header) {
+    uint64_t hash = mix(CHECK_SEED, ((uint64_t)header->magic << 32) | header->version);
+    hash = mix(hash, ((uint64_t)header->capacity << 32) | header->sample_size);
+    hash = mix(hash, header->seq);
+    return mix(hash, header->head);
+}
+
+static bool slot_valid(const TelemetryPersistFile *file, uint64_t ticket) {
+    const TelemetryPersistSlot *slot = &file->slots[ticket & PERSIST_MASK];
+    return slot->ticket == ticket && slot->check == slot_check(ticket, slot->words);
+}
+
+static bool header_valid(const TelemetryPersistHeader *header) {
+    return header->magic == TELEMETRY_PERSIST_MAGIC &&
+           header->version == TELEMETRY_PERSIST_VERSION &&
+           header->capacity == TELEMETRY_PERSIST_CAPACITY &&
+           header->sample_size == sizeof(TelemetryData) &&
+           header->check == header_check(header);
+}
+
+// ============================================
+// RECOVERY
+// ============================================
+
+/* Newest valid header copy, or NULL */
+static const TelemetryPersistHeader *latest_header(const TelemetryPersistFile *file) {
+    const TelemetryPersistHeader *best = NULL;
+    for (size_t i = 0; i < 2; i++) {
+        const TelemetryPersistHeader *header = &file->headers[i];
+        if (header_valid(header) && (best == NULL || header->seq > best->seq)) {
+            best = header;
+        }
+    }
+    return best;
+}
+
+static void recover(TelemetryPersist *persist, const TelemetryPersistHeader *header) {
+    const TelemetryPersistFile *file = persist->file;
+    uint64_t head = header->head;
+
+    // Rule 2: Both walks are bounded by the capacity
+    // Forward: appended after the last commit and intact
+    while (head - header->head < TELEMETRY_PERSIST_CAPACITY && slot_valid(file, head)) {
+        head++;
+    }
+    // A slot torn by the crash (or bad media) at the top is dropped
+    uint64_t trimmed = 0;
+    while (trimmed < TELEMETRY_PERSIST_CAPACITY && head > 0 && !slot_valid(file, head - 1)) {
+        head--;
+        trimmed++;
+    }
+    // Backward: committed samples the ring has not overwritten
+    uint64_t oldest = head;
+    while (head - oldest < TELEMETRY_PERSIST_CAPACITY && oldest > 0 &&
+           slot_valid(file, oldest - 1)) {
+        oldest--;
+    }
+
+    persist->head = head;
+    persist->oldest = oldest;
+    persist->committed_head = (header->head < head) ? header->head : head;
+    persist->seq = header->seq;
+}
+
+// ============================================
+// PUBLIC API
+// ============================================
+
+bool telemetry_persist_open(TelemetryPersist *persist, const char *path, size_t *recovered) {
+    assert(persist != NULL && path != NULL && recovered != NULL);
+
+    *recovered = 0;
+    persist->file = NULL;
+    persist->fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (persist->fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(persist->fd, &st) != 0) {
+        close(persist->fd);
+        return false;
+    }
+    bool created = (st.st_size == 0);
+    if (created && ftruncate(persist->fd, (off_t)sizeof(TelemetryPersistFile)) != 0) {
+        close(persist->fd);
+        return false;
+    }
+    if (!created && (size_t)st.st_size != sizeof(TelemetryPersistFile)) {
+        close(persist->fd);
+        return false;  // Rule 5: Another layout, leave it alone
+    }
+
+    void *map = mmap(NULL, sizeof(TelemetryPersistFile), PROT_READ | PROT_WRITE, MAP_SHARED,
+                     persist->fd, 0);
+    if (map == MAP_FAILED) {
+        close(persist->fd);
+        return false;
+    }
+    persist->file = map;
+    persist->failed = false;
+
+    const TelemetryPersistHeader *header = latest_header(persist->file);
+    bool never_committed = (persist->file->headers[0].magic == 0 &&
+                            persist->file->headers[1].magic == 0);
+    if (header == NULL && !never_committed) {
+        munmap(map, sizeof(TelemetryPersistFile));
+        close(persist->fd);
+        persist->file = NULL;
+        return false;  // Rule 5: Not ours, or from another build
+    }
+
+    if (header != NULL) {
+        recover(persist, header);
+        *recovered = (size_t)(persist->head - persist->oldest);
+        return true;
+    }
+
+    // New file (or crashed before its first commit): zero-filled slots
+    // never validate, so tickets simply start at 0
+    persist->head = 0;
+    persist->oldest = 0;
+    persist->committed_head = 0;
+    persist->seq = 0;
+    return telemetry_persist_commit(persist, true);
+}
+
+void telemetry_persist_append(TelemetryPersist *persist, const TelemetryData *sample) {
+    assert(persist != NULL && persist->file != NULL && sample != NULL);
+
+    // Zeroed copy: padding bytes are stored (and checksummed) as zeros
+    uint64_t words[TELEMETRY_PERSIST_WORDS] = {0};
+    memcpy(words, sample, sizeof(*sample));
+
+    TelemetryPersistSlot *slot = &persist->file->slots[persist->head & PERSIST_MASK];
+    slot->ticket = persist->head;
+    memcpy(slot->words, words, sizeof(words));
+    slot->check = slot_check(persist->head, words);
+
+    persist->head++;
+    if (persist->head - persist->oldest > TELEMETRY_PERSIST_CAPACITY) {
+        persist->oldest = persist->head - TELEMETRY_PERSIST_CAPACITY;
+    }
+    if (persist->head - persist->committed_head >= TELEMETRY_PERSIST_COMMIT_EVERY) {
+        (void)telemetry_persist_commit(persist, false);  // Sticky failure, see commit
+    }
+}
+
+bool telemetry_persist_commit(TelemetryPersist *persist, bool durable) {
+    assert(persist != NULL && persist->file != NULL);
+
+    TelemetryPersistFile *file = persist->file;
+    // Durable: the slots reach the disk before the header that covers them
+    if (durable && msync(file, sizeof(*file), MS_SYNC) != 0) {
+        persist->failed = true;
+    }
+
+    persist->seq++;
+    TelemetryPersistHeader *header = &file->headers[persist->seq & 1];
+    header->magic = TELEMETRY_PERSIST_MAGIC;
+    header->version = TELEMETRY_PERSIST_VERSION;
+    header->capacity = TELEMETRY_PERSIST_CAPACITY;
+    header->sample_size = sizeof(TelemetryData);
+    header->seq = persist->seq;
+    header->head = persist->head;
+    header->check = header_check(header);  // Last: a torn header never validates
+    persist->committed_head = persist->head;
+
+    if (msync(file, sizeof(file->headers), durable ? MS_SYNC : MS_ASYNC) != 0) {
+        persist->failed = true;
+    }
+    return !persist->failed;
+}
+
+uint64_t telemetry_persist_oldest(const TelemetryPersist *persist) {
+    assert(persist != NULL && persist->file != NULL);
+    return persist->oldest;
+}
+
+size_t telemetry_persist_read(const TelemetryPersist *persist, uint64_t *cursor,
+                              TelemetryData *out, size_t max) {
+    assert(persist != NULL && persist->file != NULL && cursor != NULL);
+    assert(out != NULL || max == 0);
+
+    if (*cursor < persist->oldest) {
+        *cursor = persist->oldest;  // Overwritten since the cursor was taken
+    }
+    size_t copied = 0;
+    // Rule 2: Bounded by max
+    while (copied < max && *cursor < persist->head) {
+        const TelemetryPersistSlot *slot = &persist->file->slots[*cursor & PERSIST_MASK];
+        memcpy(&out[copied], slot->words, sizeof(TelemetryData));
+        copied++;
+        (*cursor)++;
+    }
+    return copied;
+}
+
+bool telemetry_persist_close(TelemetryPersist *persist) {
+    assert(persist != NULL && persist->file != NULL);
+
+    bool ok = telemetry_persist_commit(persist, true);
+    if (munmap(persist->file, sizeof(TelemetryPersistFile)) != 0) {
+        ok = false;
+    }
+    if (close(persist->fd) != 0) {  // Rule 5
+        ok = false;
+    }
+    persist->file = NULL;
+    return ok;
+}
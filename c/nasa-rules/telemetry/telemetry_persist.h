@@ -0,0 +1,105 @@
+/*
+ * TELEMETRY PERSIST - Crash-consistent telemetry ring in a mapped file
+ *
+ * The newest TELEMETRY_PERSIST_CAPACITY samples live in a file mapped
+ * MAP_SHARED. Appending is a 48-byte store into the mapping (no
+ * syscall): the page cache holds the data, so a crash of the process
+ * loses nothing, and msync() bounds what a power loss can lose.
+ *
+ * Commit protocol:
+ * - Every slot stores its ticket and a checksum of ticket + sample, so a
+ *   torn or stale slot is recognized on its own.
+ * - Two header copies alternate: commit n writes copy n % 2 with seq n,
+ *   head and a checksum. A torn header write leaves the other copy, the
+ *   previous commit, intact.
+ * - Commits run every TELEMETRY_PERSIST_COMMIT_EVERY appends with
+ *   msync(MS_ASYNC); telemetry_persist_commit(p, true) writes the slots
+ *   with MS_SYNC before the header, for a durable point.
+ *
+ * Recovery (telemetry_persist_open on an existing file) takes the valid
+ * header with the highest seq, walks forward from its head over slots
+ * that still validate (samples appended after the last commit) and back
+ * over the committed ones: samples are read in place, nothing is
+ * replayed or parsed.
+ *
+ * One writer thread. The file is not portable across builds with a
+ * different layout (checked through the header).
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c telemetry_persist.c
+ */
+
+#ifndef TELEMETRY_PERSIST_H
+#define TELEMETRY_PERSIST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "telemetry_types.h"
+
+#ifndef TELEMETRY_PERSIST_CAPACITY
+#define TELEMETRY_PERSIST_CAPACITY 4096     /* Power of two (Rule 3: fixed) */
+#endif
+
+#define TELEMETRY_PERSIST_COMMIT_EVERY 256  /* Appends between async commits */
+#define TELEMETRY_PERSIST_MAGIC 0x54504552u /* "TPER" */
+#define TELEMETRY_PERSIST_VERSION 1u
+#define TELEMETRY_PERSIST_WORDS ((sizeof(TelemetryData) + 7) / 8)
+
+typedef struct {
+    _Alignas(64) uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t sample_size;
+    uint64_t seq;       /* Commit number; copy seq % 2 */
+    uint64_t head;      /* Tickets committed: [head - capacity, head) */
+    uint64_t check;     /* Over every field above */
+} TelemetryPersistHeader;
+
+typedef struct {
+    uint64_t ticket;
+    uint64_t words[TELEMETRY_PERSIST_WORDS];  /* TelemetryData, zero-padded */
+    uint64_t check;                           /* Over ticket and words */
+} TelemetryPersistSlot;
+
+/* The file, as mapped */
+typedef struct {
+    TelemetryPersistHeader headers[2];
+    TelemetryPersistSlot slots[TELEMETRY_PERSIST_CAPACITY];
+} TelemetryPersistFile;
+
+typedef struct {
+    TelemetryPersistFile *file;
+    int fd;
+    uint64_t head;            /* Next ticket */
+    uint64_t oldest;          /* Oldest ticket still held */
+    uint64_t committed_head;  /* head of the last commit */
+    uint64_t seq;             /* Last commit number */
+    bool failed;              /* Sticky: an msync() failed */
+} TelemetryPersist;
+
+/* Map path, creating it if missing. An existing file is recovered; *recovered
+ * gets the number of samples found. False if it cannot be mapped or has
+ * another layout (it is left untouched). */
+bool telemetry_persist_open(TelemetryPersist *persist, const char *path, size_t *recovered);
+
+/* Store one sample in the mapping; commits every TELEMETRY_PERSIST_COMMIT_EVERY */
+void telemetry_persist_append(TelemetryPersist *persist, const TelemetryData *sample);
+
+/* Publish a new header for everything appended. durable: the slots and
+ * then the header reach the disk before returning. False once any
+ * msync() failed. */
+bool telemetry_persist_commit(TelemetryPersist *persist, bool durable);
+
+/* Oldest ticket still held: start a telemetry_persist_read cursor here */
+uint64_t telemetry_persist_oldest(const TelemetryPersist *persist);
+
+/* Copy up to max samples from ticket *cursor on, oldest first, and
+ * advance the cursor */
+size_t telemetry_persist_read(const TelemetryPersist *persist, uint64_t *cursor,
+                              TelemetryData *out, size_t max);
+
+/* Durable commit, unmap and close */
+bool telemetry_persist_close(TelemetryPersist *persist);
+
+#endif /* TELEMETRY_PERSIST_H */
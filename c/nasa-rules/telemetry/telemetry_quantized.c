@@ -0,0 +1,219 @@
+/*
+ * TELEMETRY QUANTIZED - Implementation
+ */
+
+#include "telemetry_quantized.h"
+
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+#include "quantize.h"
+#include "reduce.h"
+
+#define HALF_FINITE_MAX 65504.0
+#define TIME_OFFSET_MAX 65535u
+#define SENSOR_ID_MAX 65535
+
+// ============================================
+// BLOCKS
+// ============================================
+
+/* Rule 4: Small function - count values of a sealed block to float */
+static void decode_block(const TelemetryQuantizedBlock *block, float *out) {
+    if (block->format == TELEMETRY_QUANTIZED_FLOAT16) {
+        dequantize_float16(block->values.half, block->count, block->offset, out);
+    } else {
+        QuantizeInt16 params = {block->scale, block->offset};
+        dequantize_int16(block->values.scaled, block->count, params, out);
+    }
+}
+
+/* Encode the open block into the ring slot it takes */
+static void seal_open_block(TelemetryQuantized *store) {
+    TelemetryQuantizedBlock *open = &store->open;
+    assert(open->count > 0);  // Rule 7
+
+    size_t slot = (store->first + store->sealed) % TELEMETRY_QUANTIZED_BLOCKS;
+    if (store->sealed == TELEMETRY_QUANTIZED_BLOCKS) {
+        // Ring full: the slot is the oldest block, drop it
+        store->held -= store->blocks[store->first].count;
+        store->first = (store->first + 1) % TELEMETRY_QUANTIZED_BLOCKS;
+        store->sealed--;
+    }
+
+    double min = 0.0;
+    double max = 0.0;
+    reduce_min_max_double(store->pending, open->count, &min, &max);
+    QuantizeInt16 params = quantize_int16_params(min, max);
+
+    open->offset = params.offset;
+    open->scale = params.scale;
+    open->format = TELEMETRY_QUANTIZED_INT16;
+    bool half_fits = (max - (double)params.offset < HALF_FINITE_MAX &&
+                      (double)params.offset - min < HALF_FINITE_MAX);
+    if (store->format == TELEMETRY_QUANTIZED_FLOAT16 && half_fits) {
+        open->format = TELEMETRY_QUANTIZED_FLOAT16;
+        quantize_float16(store->pending, open->count, params.offset, open->values.half);
+    } else {
+        quantize_int16(store->pending, open->count, params, open->values.scaled);
+    }
+
+    // Measured, not derived: what a reader of this block can rely on
+    float decoded[TELEMETRY_QUANTIZED_BLOCK];
+    decode_block(open, decoded);
+    double worst = 0.0;
+    for (size_t i = 0; i < open->count; i++) {
+        double error = fabs((double)decoded[i] - store->pending[i]);
+        worst = (error > worst) ? error : worst;
+    }
+    // Rounded up to float so the stored bound never understates the error
+    float bound = (float)worst;
+    open->max_error = ((double)bound < worst) ? nextafterf(bound, INFINITY) : bound;
+
+    store->blocks[slot] = *open;
+    store->sealed++;
+    store->held += open->count;
+    open->count = 0;
+}
+
+/* The index-th sample lives in block *block at position *position */
+static const TelemetryQuantizedBlock *locate(const TelemetryQuantized *store, size_t index,
+                                           size_t *position) {
+    // Rule 2: At most TELEMETRY_QUANTIZED_BLOCKS blocks
+    for (size_t b = 0; b < store->sealed; b++) {
+        const TelemetryQuantizedBlock *block =
+            &store->blocks[(store->first + b) % TELEMETRY_QUANTIZED_BLOCKS];
+        if (index < block->count) {
+            *position = index;
+            return block;
+        }
+        index -= block->count;
+    }
+    *position = index;
+    return (index < store->open.count) ? &store->open : NULL;
+}
+
+// ============================================
+// PUBLIC API
+// ============================================
+
+void telemetry_quantized_init(TelemetryQuantized *store, TelemetryQuantizedFormat format) {
+    assert(store != NULL);  // Rule 7
+
+    store->first = 0;
+    store->sealed = 0;
+    store->held = 0;
+    store->format = format;
+    store->open.count = 0;
+}
+
+bool telemetry_quantized_append(TelemetryQuantized *store, const TelemetryData *sample) {
+    assert(store != NULL && sample != NULL);  // Rule 7
+
+    if (!sample->valid || !isfinite(sample->temperature) ||
+        sample->sensor_id < 0 || sample->sensor_id > SENSOR_ID_MAX) {
+        return false;
+    }
+
+    TelemetryQuantizedBlock *open = &store->open;
+    if (open->count > 0 &&
+        (open->count == TELEMETRY_QUANTIZED_BLOCK ||
+         sample->timestamp < open->base_timestamp ||
+         sample->timestamp - open->base_timestamp > TIME_OFFSET_MAX)) {
+        seal_open_block(store);
+    }
+    if (open->count == 0) {
+        open->base_timestamp = sample->timestamp;
+    }
+
+    size_t i = open->count;
+    store->pending[i] = sample->temperature;
+    open->sensor_ids[i] = (uint16_t)sample->sensor_id;
+    open->time_offsets[i] = (uint16_t)(sample->timestamp - open->base_timestamp);
+    open->count++;
+    return true;
+}
+
+size_t telemetry_quantized_count(const TelemetryQuantized *store) {
+    assert(store != NULL);  // Rule 7
+    return store->held + store->open.count;
+}
+
+size_t telemetry_quantized_decode(const TelemetryQuantized *store, float *out, size_t max) {
+    assert(store != NULL && (out != NULL || max == 0));  // Rule 7
+
+    float partial[TELEMETRY_QUANTIZED_BLOCK];
+    size_t copied = 0;
+    // Rule 2: Bounded by the number of sealed blocks
+    for (size_t b = 0; b < store->sealed && copied < max; b++) {
+        const TelemetryQuantizedBlock *block =
+            &store->blocks[(store->first + b) % TELEMETRY_QUANTIZED_BLOCKS];
+        if (max - copied >= block->count) {
+            decode_block(block, out + copied);  // Straight into the caller
+            copied += block->count;
+        } else {
+            decode_block(block, partial);
+            memcpy(out + copied, partial, (max - copied) * sizeof(float));
+            copied = max;
+        }
+    }
+    for (size_t i = 0; i < store->open.count && copied < max; i++) {
+        out[copied++] = (float)store->pending[i];
+    }
+    return copied;
+}
+
+double telemetry_quantized_sum(const TelemetryQuantized *store) {
+    assert(store != NULL);  // Rule 7
+
+    float decoded[TELEMETRY_QUANTIZED_BLOCK];
+    double sum = 0.0;
+    // Rule 2: Bounded by the number of sealed blocks
+    for (size_t b = 0; b < store->sealed; b++) {
+        const TelemetryQuantizedBlock *block =
+            &store->blocks[(store->first + b) % TELEMETRY_QUANTIZED_BLOCKS];
+        decode_block(block, decoded);
+        sum += reduce_sum_float(decoded, block->count, sizeof(float));
+    }
+    return sum + reduce_sum_double(store->pending, store->open.count);
+}
+
+bool telemetry_quantized_get(const TelemetryQuantized *store, size_t index, TelemetryData *out) {
+    assert(store != NULL && out != NULL);  // Rule 7
+
+    size_t position = 0;
+    const TelemetryQuantizedBlock *block = locate(store, index, &position);
+    if (block == NULL) {
+        return false;
+    }
+
+    if (block == &store->open) {
+        out->temperature = store->pending[position];
+    } else {
+        float value = 0.0f;
+        if (block->format == TELEMETRY_QUANTIZED_FLOAT16) {
+            dequantize_float16(&block->values.half[position], 1, block->offset, &value);
+        } else {
+            QuantizeInt16 params = {block->scale, block->offset};
+            dequantize_int16(&block->values.scaled[position], 1, params, &value);
+        }
+        out->temperature = value;
+    }
+    out->sensor_id = block->sensor_ids[position];
+    out->timestamp = block->base_timestamp + block->time_offsets[position];
+    out->valid = true;
+    out->time_ns = 0;
+    return true;
+}
+
+double telemetry_quantized_max_error(const TelemetryQuantized *store) {
+    assert(store != NULL);  // Rule 7
+
+    double worst = 0.0;
+    for (size_t b = 0; b < store->sealed; b++) {
+        double error = store->blocks[(store->first + b) % TELEMETRY_QUANTIZED_BLOCKS].max_error;
+        worst = (error > worst) ? error : worst;
+    }
+    return worst;
+}
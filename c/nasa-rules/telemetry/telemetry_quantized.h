@@ -0,0 +1,101 @@
+/*
+ * TELEMETRY QUANTIZED - Quantized long history of telemetry samples
+ *
+ * An opt-in store keeping ~5x more samples than TelemetryData in the same
+ * static memory: samples are grouped in blocks of TELEMETRY_QUANTIZED_BLOCK
+ * columns
+ *   values        int16 codes or binary16 (common/quantize.h)
+ *   sensor_ids    uint16
+ *   time_offsets  uint16 seconds after the block's base_timestamp
+ * i.e. 6 bytes per sample plus a 24-byte block header, against 32 bytes
+ * for a TelemetryData. The newest block stays exact (doubles) until it is
+ * full; sealing it picks the block's scale/offset from its min/max,
+ * encodes the values and records the largest error actually made.
+ *
+ * Error bound per block, with range = max - min of the block:
+ *   INT16    range / 131068 + 2^-24 (|x - offset| + |x|):
+ *            < 0.001 for a 100-degree spread
+ *   FLOAT16  2^-11 |x - offset| + 2^-25 + 2^-24 |x|: relative to the
+ *            distance from the block midpoint, so finer than INT16 for
+ *            readings near a set point and up to 16x coarser for rare
+ *            excursions; a block out of binary16 range is stored as INT16
+ * telemetry_quantized_max_error reports the measured worst case.
+ *
+ * Not kept: time_ns and invalid samples. Samples with a sensor id outside
+ * 0..65535 are refused. A timestamp going backwards or more than 65535 s
+ * past the block base seals the block early.
+ *
+ * Decoding to float (SIMD) is the analytics path; telemetry_quantized_get
+ * rebuilds one TelemetryData at a time.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c telemetry_quantized.c
+ */
+
+#ifndef TELEMETRY_QUANTIZED_H
+#define TELEMETRY_QUANTIZED_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "telemetry_types.h"
+
+#ifndef TELEMETRY_QUANTIZED_BLOCKS
+#define TELEMETRY_QUANTIZED_BLOCKS 64  /* Sealed blocks held (Rule 3: fixed) */
+#endif
+
+#define TELEMETRY_QUANTIZED_BLOCK 256  /* Samples per block */
+
+typedef enum {
+    TELEMETRY_QUANTIZED_INT16 = 0,   /* Scaled int16: uniform absolute error */
+    TELEMETRY_QUANTIZED_FLOAT16 = 1  /* binary16 around the block midpoint */
+} TelemetryQuantizedFormat;
+
+typedef struct {
+    union {
+        int16_t scaled[TELEMETRY_QUANTIZED_BLOCK];
+        uint16_t half[TELEMETRY_QUANTIZED_BLOCK];
+    } values;
+    uint16_t sensor_ids[TELEMETRY_QUANTIZED_BLOCK];
+    uint16_t time_offsets[TELEMETRY_QUANTIZED_BLOCK];
+    uint32_t base_timestamp;
+    float scale;       /* INT16 only */
+    float offset;
+    float max_error;   /* Measured when sealed, rounded up */
+    uint16_t count;
+    uint8_t format;    /* TelemetryQuantizedFormat actually used */
+} TelemetryQuantizedBlock;
+
+typedef struct {
+    TelemetryQuantizedBlock blocks[TELEMETRY_QUANTIZED_BLOCKS];  /* Sealed, ring */
+    size_t first;    /* Oldest sealed block */
+    size_t sealed;   /* Sealed blocks held */
+    size_t held;     /* Samples in the sealed blocks */
+    TelemetryQuantizedFormat format;
+    TelemetryQuantizedBlock open;               /* Ids and times of the open block */
+    double pending[TELEMETRY_QUANTIZED_BLOCK];  /* Its exact values */
+} TelemetryQuantized;
+
+void telemetry_quantized_init(TelemetryQuantized *store, TelemetryQuantizedFormat format);
+
+/* Keep a valid sample; the oldest block goes once all blocks are sealed.
+ * False (nothing stored) if invalid, not finite or the id is out of range. */
+bool telemetry_quantized_append(TelemetryQuantized *store, const TelemetryData *sample);
+
+/* Samples held, sealed and open */
+size_t telemetry_quantized_count(const TelemetryQuantized *store);
+
+/* Decode up to max temperatures, oldest first; returns how many */
+size_t telemetry_quantized_decode(const TelemetryQuantized *store, float *out, size_t max);
+
+/* Sum of the temperatures held, decoded one block at a time on the stack
+ * (the caller needs no buffer for the whole history) */
+double telemetry_quantized_sum(const TelemetryQuantized *store);
+
+/* The index-th sample, oldest first (time_ns = 0) */
+bool telemetry_quantized_get(const TelemetryQuantized *store, size_t index, TelemetryData *out);
+
+/* Largest error of the sealed blocks held (0 while none) */
+double telemetry_quantized_max_error(const TelemetryQuantized *store);
+
+#endif /* TELEMETRY_QUANTIZED_H */
@@ -0,0 +1,188 @@
+/*
+ * TELEMETRY RING - Implementation
+ *
+ * Memory ordering follows the C11 seqlock recipe:
+ *   writer: claim seq = 2t+1, release fence, relaxed payload stores,
+ *           store seq = 2t+2 with release
+ *   reader: load seq with acquire, relaxed payload loads, acquire
+ *           fence, reload seq and compare
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "telemetry_ring.h"
+
+#include <assert.h>
+#include <sched.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_RELAX() __builtin_ia32_pause()
+#else
+#define CPU_RELAX() ((void)0)
+#endif
+
+#define RING_PAUSE_SPINS 64  // Then yield: the stalled writer may need this CPU
+
+#define RING_MASK ((uint64_t)TELEMETRY_RING_CAPACITY - 1)
+
+_Static_assert((TELEMETRY_RING_CAPACITY & (TELEMETRY_RING_CAPACITY - 1)) == 0,
+               "TELEMETRY_RING_CAPACITY must be a power of two");
+
+typedef enum {
+    SLOT_READ_OK,
+    SLOT_READ_PENDING,     /* Ticket claimed but not published yet */
+    SLOT_READ_OVERWRITTEN  /* A newer lap owns the slot */
+} SlotRead;
+
+static inline uint64_t writing_seq(uint64_t ticket) {
+    return 2 * ticket + 1;
+}
+
+static inline uint64_t published_seq(uint64_t ticket) {
+    return 2 * ticket + 2;
+}
+
+static SlotRead read_slot(const TelemetryRing *ring, uint64_t ticket, TelemetryData *out) {
+    const TelemetryRingSlot *slot = &ring->slots[ticket & RING_MASK];
+    const uint64_t expected = published_seq(ticket);
+
+    uint64_t before = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    if (before != expected) {
+        return (before < expected) ? SLOT_READ_PENDING : SLOT_READ_OVERWRITTEN;
+    }
+
+    uint64_t words[TELEMETRY_RING_WORDS];
+    for (size_t w = 0; w < TELEMETRY_RING_WORDS; w++) {
+        words[w] = atomic_load_explicit(&slot->words[w], memory_order_relaxed);
+    }
+    atomic_thread_fence(memory_order_acquire);
+
+    // Any change means a newer lap started writing during the copy
+    if (atomic_load_explicit(&slot->seq, memory_order_relaxed) != expected) {
+        return SLOT_READ_OVERWRITTEN;
+    }
+    memcpy(out, words, sizeof(*out));
+    return SLOT_READ_OK;
+}
+
+void telemetry_ring_init(TelemetryRing *ring) {
+    assert(ring != NULL);
+
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->dropped, 0);
+    for (size_t i = 0; i < TELEMETRY_RING_CAPACITY; i++) {
+        atomic_init(&ring->slots[i].seq, 0);
+        for (size_t w = 0; w < TELEMETRY_RING_WORDS; w++) {
+            atomic_init(&ring->slots[i].words[w], 0);
+        }
+    }
+}
+
+bool telemetry_ring_publish(TelemetryRing *ring, const TelemetryData *sample) {
+    assert(ring != NULL && sample != NULL);
+
+    const uint64_t ticket = atomic_fetch_add_explicit(&ring->head, 1, memory_order_relaxed);
+    TelemetryRingSlot *slot = &ring->slots[ticket & RING_MASK];
+    const uint64_t claim = writing_seq(ticket);
+
+    // Wait (bounded) for the previous lap's writer to leave the slot
+    uint64_t seq = atomic_load_explicit(&slot->seq, memory_order_relaxed);
+    bool claimed = false;
+    for (int spin = 0; spin < TELEMETRY_RING_MAX_SPINS && !claimed; spin++) {
+        if (seq >= claim) {
+            break;  // A later lap already took the slot: this sample is stale
+        }
+        if (seq & 1) {
+            if (spin < RING_PAUSE_SPINS) {
+                CPU_RELAX();
+            } else {
+                (void)sched_yield();
+            }
+            seq = atomic_load_explicit(&slot->seq, memory_order_relaxed);
+            continue;
+        }
+        claimed = atomic_compare_exchange_weak_explicit(&slot->seq, &seq, claim,
+                                                        memory_order_acquire,
+                                                        memory_order_relaxed);
+    }
+    if (!claimed) {
+        atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+        return false;
+    }
+    atomic_thread_fence(memory_order_release);
+
+    // Zeroed copy: padding bytes are stored as defined values
+    uint64_t words[TELEMETRY_RING_WORDS] = {0};
+    memcpy(words, sample, sizeof(*sample));
+    for (size_t w = 0; w < TELEMETRY_RING_WORDS; w++) {
+        atomic_store_explicit(&slot->words[w], words[w], memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&slot->seq, published_seq(ticket), memory_order_release);
+    return true;
+}
+
+size_t telemetry_ring_snapshot(const TelemetryRing *ring, TelemetryData *out, size_t max) {
+    assert(ring != NULL && (out != NULL || max == 0));
+
+    const uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    const uint64_t oldest = (head > TELEMETRY_RING_CAPACITY) ? head - TELEMETRY_RING_CAPACITY : 0;
+
+    // Newest first into out, then reverse. Rule 2: at most CAPACITY tickets
+    size_t found = 0;
+    for (uint64_t ticket = head; ticket > oldest && found < max; ticket--) {
+        SlotRead status = read_slot(ring, ticket - 1, &out[found]);
+        if (status == SLOT_READ_OVERWRITTEN) {
+            break;  // Every older ticket has been overwritten too
+        }
+        if (status == SLOT_READ_OK) {
+            found++;
+        }
+    }
+
+    for (size_t i = 0; i < found / 2; i++) {
+        TelemetryData tmp = out[i];
+        out[i] = out[found - 1 - i];
+        out[found - 1 - i] = tmp;
+    }
+    return found;
+}
+
+size_t telemetry_ring_read(const TelemetryRing *ring, uint64_t *cursor,
+                           TelemetryData *out, size_t max, uint64_t *lost) {
+    assert(ring != NULL && cursor != NULL && lost != NULL);
+    assert(out != NULL || max == 0);
+
+    const uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    if (head - *cursor > TELEMETRY_RING_CAPACITY) {
+        *lost += head - TELEMETRY_RING_CAPACITY - *cursor;
+        *cursor = head - TELEMETRY_RING_CAPACITY;
+    }
+
+    // Rule 2: at most CAPACITY tickets between cursor and head
+    size_t copied = 0;
+    while (copied < max && *cursor < head) {
+        SlotRead status = read_slot(ring, *cursor, &out[copied]);
+        if (status == SLOT_READ_PENDING) {
+            break;  // Keep order: resume here on the next call
+        }
+        if (status == SLOT_READ_OK) {
+            copied++;
+        } else {
+            (*lost)++;
+        }
+        (*cursor)++;
+    }
+    return copied;
+}
+
+uint64_t telemetry_ring_published(const TelemetryRing *ring) {
+    assert(ring != NULL);
+    return atomic_load_explicit(&ring->head, memory_order_relaxed);
+}
+
+uint64_t telemetry_ring_dropped(const TelemetryRing *ring) {
+    assert(ring != NULL);
+    return atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+}
@@ -0,0 +1,75 @@
+/*
+ * TELEMETRY RING - Multi-producer overwrite ring with lock-free readers
+ *
+ * Any number of acquisition threads publish samples; the newest
+ * TELEMETRY_RING_CAPACITY stay readable and older ones are overwritten,
+ * never rejected.
+ *
+ * - A producer claims ticket t with one fetch-add on head; ticket t
+ *   lives in slot t % TELEMETRY_RING_CAPACITY.
+ * - Each slot is a seqlock: seq is 2t + 1 while ticket t is written and
+ *   2t + 2 once it is published. A reader copies the payload between two
+ *   reads of seq and keeps it only if both equal 2t + 2, so it never sees
+ *   a half-written sample and needs no lock.
+ * - A producer only enters a slot nobody is writing. If the previous lap's
+ *   writer stalls for TELEMETRY_RING_MAX_SPINS, the sample is dropped and
+ *   counted instead of blocking acquisition (Rule 2).
+ *
+ * The payload is stored as relaxed atomic words, so concurrent reads and
+ * writes are well defined in C11.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c telemetry_ring.c
+ */
+
+#ifndef TELEMETRY_RING_H
+#define TELEMETRY_RING_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "telemetry_types.h"
+
+#ifndef TELEMETRY_RING_CAPACITY
+#define TELEMETRY_RING_CAPACITY 1024  /* Power of two (Rule 3: fixed) */
+#endif
+
+#define TELEMETRY_RING_MAX_SPINS 4096
+#define TELEMETRY_RING_WORDS ((sizeof(TelemetryData) + 7) / 8)
+
+/* One cache line per slot: neighbouring producers do not false-share */
+typedef struct {
+    _Alignas(64) _Atomic uint64_t seq;  /* 0 empty, 2t+1 writing, 2t+2 published */
+    _Atomic uint64_t words[TELEMETRY_RING_WORDS];
+} TelemetryRingSlot;
+
+typedef struct {
+    _Alignas(64) _Atomic uint64_t head;  /* Next ticket */
+    _Alignas(64) _Atomic uint64_t dropped;
+    TelemetryRingSlot slots[TELEMETRY_RING_CAPACITY];
+} TelemetryRing;
+
+void telemetry_ring_init(TelemetryRing *ring);
+
+/* Thread-safe. False if the sample was dropped (stalled writer or lapped) */
+bool telemetry_ring_publish(TelemetryRing *ring, const TelemetryData *sample);
+
+/* Thread-safe. The newest published samples, at most max, oldest first.
+ * Tickets still being written are skipped. */
+size_t telemetry_ring_snapshot(const TelemetryRing *ring, TelemetryData *out, size_t max);
+
+/* Thread-safe for distinct cursors. Copy up to max samples starting at
+ * ticket *cursor (start at 0), advance the cursor past them and add the
+ * number of overwritten samples to *lost. Stops at the first ticket not
+ * yet published; a dropped ticket holds the cursor until the ring laps it. */
+size_t telemetry_ring_read(const TelemetryRing *ring, uint64_t *cursor,
+                           TelemetryData *out, size_t max, uint64_t *lost);
+
+/* Tickets handed out so far */
+uint64_t telemetry_ring_published(const TelemetryRing *ring);
+
+/* Samples dropped by telemetry_ring_publish */
+uint64_t telemetry_ring_dropped(const TelemetryRing *ring);
+
+#endif /* TELEMETRY_RING_H */
@@ -0,0 +1,245 @@
+/*
+ * TELEMETRY ROLLUP - Implementation
+ */
+
+#include "telemetry_rollup.h"
+
+#include <assert.h>
+#include <string.h>
+
+/* Rule 2: Pieces of one summary - edge seconds and minutes, plus hours */
+#define MAX_SUMMARY_PIECES (4 * 60 + TELEMETRY_ROLLUP_HOURS + 4)
+
+typedef struct {
+    uint32_t width;     /* Seconds per bucket */
+    uint32_t capacity;  /* Buckets in the ring */
+    uint32_t base;      /* First bucket in TelemetryRollup.buckets */
+} LevelShape;
+
+static const LevelShape LEVELS[TELEMETRY_ROLLUP_LEVELS] = {
+    {1, TELEMETRY_ROLLUP_SECONDS, 0},
+    {60, TELEMETRY_ROLLUP_MINUTES, TELEMETRY_ROLLUP_SECONDS},
+    {3600, TELEMETRY_ROLLUP_HOURS, TELEMETRY_ROLLUP_SECONDS + TELEMETRY_ROLLUP_MINUTES}
+};
+
+// ============================================
+// BUCKETS
+// ============================================
+
+/* Oldest bucket index a level still holds (all of them before it wraps) */
+static uint32_t first_covered(const TelemetryRollup *rollup, int level) {
+    uint32_t newest = rollup->newest / LEVELS[level].width;
+    return (newest >= LEVELS[level].capacity) ? newest - LEVELS[level].capacity + 1 : 0;
+}
+
+static bool covered(const TelemetryRollup *rollup, int level, uint32_t index) {
+    return rollup->any && index >= first_covered(rollup, level);
+}
+
+static size_t slot_of(int level, uint32_t index) {
+    return LEVELS[level].base + index % LEVELS[level].capacity;
+}
+
+/* The bucket for index if it holds samples, else NULL */
+static const TelemetryRollupBucket *bucket_at(const TelemetryRollup *rollup, int level,
+                                              uint32_t index) {
+    const TelemetryRollupBucket *bucket = &rollup->buckets[slot_of(level, index)];
+    return (bucket->count > 0 && bucket->index == index) ? bucket : NULL;
+}
+
+static void fold_bucket(TelemetryRollupSummary *out, const TelemetryRollupBucket *bucket) {
+    if (bucket == NULL) {
+        return;  // Covered but empty: no samples in that interval
+    }
+    if (out->count == 0 || bucket->min < out->min) {
+        out->min = bucket->min;
+    }
+    if (out->count == 0 || bucket->max > out->max) {
+        out->max = bucket->max;
+    }
+    out->count += bucket->count;
+    out->sum += bucket->sum;
+}
+
+/* Coarsest level with a whole bucket at t inside [t, to), or -1 */
+static int fitting_level(const TelemetryRollup *rollup, uint64_t t, uint64_t to) {
+    for (int level = TELEMETRY_ROLLUP_LEVELS - 1; level >= 0; level--) {
+        uint32_t width = LEVELS[level].width;
+        if (t % width == 0 && t + width <= to && covered(rollup, level, (uint32_t)(t / width))) {
+            return level;
+        }
+    }
+    return -1;
+}
+
+/* Finest level still holding the bucket around t, or -1 */
+static int widening_level(const TelemetryRollup *rollup, uint64_t t) {
+    for (int level = 0; level < TELEMETRY_ROLLUP_LEVELS; level++) {
+        if (covered(rollup, level, (uint32_t)(t / LEVELS[level].width))) {
+            return level;
+        }
+    }
+    return -1;
+}
+
+// ============================================
+// RAW SAMPLES
+// ============================================
+
+static bool raw_expired(const TelemetryRollup *rollup, uint32_t timestamp) {
+    return (uint64_t)timestamp + TELEMETRY_ROLLUP_RAW_SECONDS <= rollup->newest;
+}
+
+static void raw_push(TelemetryRollup *rollup, const TelemetryData *sample) {
+    // Rule 2: Bounded by raw_count; amortized O(1) per sample
+    while (rollup->raw_count > 0 && raw_expired(rollup, rollup->raw[rollup->raw_tail].timestamp)) {
+        rollup->raw_tail = (rollup->raw_tail + 1) % TELEMETRY_ROLLUP_RAW_CAPACITY;
+        rollup->raw_count--;
+    }
+    if (raw_expired(rollup, sample->timestamp)) {
+        return;  // Late sample, already past raw retention
+    }
+    if (rollup->raw_count == TELEMETRY_ROLLUP_RAW_CAPACITY) {
+        rollup->raw_tail = (rollup->raw_tail + 1) % TELEMETRY_ROLLUP_RAW_CAPACITY;
+        rollup->raw_count--;
+    }
+    size_t slot = (rollup->raw_tail + rollup->raw_count) % TELEMETRY_ROLLUP_RAW_CAPACITY;
+    rollup->raw[slot] = *sample;
+    rollup->raw_count++;
+}
+
+// ============================================
+// PUBLIC API
+// ============================================
+
+void telemetry_rollup_init(TelemetryRollup *rollup) {
+    assert(rollup != NULL);  // Rule 7
+    memset(rollup, 0, sizeof(*rollup));
+}
+
+void telemetry_rollup_add(TelemetryRollup *rollup, const TelemetryData *sample) {
+    assert(rollup != NULL && sample != NULL);  // Rule 7
+
+    if (!sample->valid) {
+        return;
+    }
+    if (!rollup->any || sample->timestamp > rollup->newest) {
+        rollup->newest = sample->timestamp;
+        rollup->any = true;
+    }
+
+    for (int level = 0; level < TELEMETRY_ROLLUP_LEVELS; level++) {
+        uint32_t index = sample->timestamp / LEVELS[level].width;
+        if (!covered(rollup, level, index)) {
+            continue;  // Older than this level's window
+        }
+        // Within the window a slot holds this index or an expired one
+        TelemetryRollupBucket *bucket = &rollup->buckets[slot_of(level, index)];
+        if (bucket->count == 0 || bucket->index != index) {
+            bucket->index = index;
+            bucket->count = 0;
+            bucket->sum = 0.0;
+            bucket->min = sample->temperature;
+            bucket->max = sample->temperature;
+        }
+        bucket->count++;
+        bucket->sum += sample->temperature;
+        bucket->min = (sample->temperature < bucket->min) ? sample->temperature : bucket->min;
+        bucket->max = (sample->temperature > bucket->max) ? sample->temperature : bucket->max;
+    }
+
+    raw_push(rollup, sample);
+}
+
+void telemetry_rollup_summarize(const TelemetryRollup *rollup, uint32_t from, uint32_t to,
+                                TelemetryRollupSummary *out) {
+    assert(rollup != NULL && out != NULL);  // Rule 7
+
+    memset(out, 0, sizeof(*out));
+    out->exact = true;
+    if (!rollup->any) {
+        return;
+    }
+
+    uint64_t end = ((uint64_t)to < (uint64_t)rollup->newest + 1) ? to : (uint64_t)rollup->newest + 1;
+    uint64_t t = from;
+    // Rule 2: Bounded number of pieces
+    for (int piece = 0; piece < MAX_SUMMARY_PIECES && t < end; piece++) {
+        int level = fitting_level(rollup, t, end);
+        if (level < 0) {
+            level = widening_level(rollup, t);
+            out->exact = false;
+        }
+        if (level < 0) {
+            // Older than every level: only the hours still held remain
+            t = (uint64_t)first_covered(rollup, TELEMETRY_ROLLUP_HOUR) * 3600u;
+            continue;
+        }
+        uint32_t width = LEVELS[level].width;
+        uint32_t index = (uint32_t)(t / width);
+        fold_bucket(out, bucket_at(rollup, level, index));
+        t = ((uint64_t)index + 1) * width;
+    }
+    if (t < end) {
+        out->exact = false;  // Not reached with well-formed levels
+    }
+}
+
+size_t telemetry_rollup_series(const TelemetryRollup *rollup, uint32_t from, uint32_t to,
+                               size_t max_points, TelemetryRollupBucket *out,
+                               TelemetryRollupLevel *level) {
+    assert(rollup != NULL && level != NULL && (out != NULL || max_points == 0));  // Rule 7
+
+    *level = TELEMETRY_ROLLUP_HOUR;
+    if (!rollup->any || from >= to || max_points == 0) {
+        return 0;
+    }
+    for (int l = 0; l < TELEMETRY_ROLLUP_LEVELS; l++) {
+        uint32_t width = LEVELS[l].width;
+        uint64_t buckets = (uint64_t)(to - 1) / width - from / width + 1;
+        if (buckets <= max_points && covered(rollup, l, from / width)) {
+            *level = (TelemetryRollupLevel)l;
+            break;
+        }
+    }
+
+    uint32_t width = LEVELS[*level].width;
+    uint32_t first = from / width;
+    uint32_t oldest = first_covered(rollup, *level);
+    first = (first > oldest) ? first : oldest;
+    uint32_t last = (to - 1) / width;
+    uint32_t newest = rollup->newest / width;
+    last = (last < newest) ? last : newest;
+
+    size_t written = 0;
+    // Rule 2: At most one ring of buckets, and max_points written
+    for (uint64_t index = first; index <= last && written < max_points; index++) {
+        const TelemetryRollupBucket *bucket = bucket_at(rollup, *level, (uint32_t)index);
+        if (bucket != NULL) {
+            out[written++] = *bucket;
+        }
+    }
+    return written;
+}
+
+size_t telemetry_rollup_raw(const TelemetryRollup *rollup, uint32_t from, uint32_t to,
+                            TelemetryData *out, size_t max) {
+    assert(rollup != NULL && (out != NULL || max == 0));  // Rule 7
+
+    size_t copied = 0;
+    // Rule 2: Bounded by the raw ring
+    for (size_t i = 0; i < rollup->raw_count && copied < max; i++) {
+        const TelemetryData *sample =
+            &rollup->raw[(rollup->raw_tail + i) % TELEMETRY_ROLLUP_RAW_CAPACITY];
+        if (sample->timestamp >= from && sample->timestamp < to &&
+            !raw_expired(rollup, sample->timestamp)) {
+            out[copied++] = *sample;
+        }
+    }
+    return copied;
+}
+
+uint32_t telemetry_rollup_width(TelemetryRollupLevel level) {
+    assert(level < TELEMETRY_ROLLUP_LEVELS);  // Rule 7
+    return LEVELS[level].width;
+}
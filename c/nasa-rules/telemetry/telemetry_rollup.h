@@ -0,0 +1,114 @@
+/*
+ * TELEMETRY ROLLUP - Multi-resolution retention in fixed rings
+ *
+ * Keeps one telemetry stream at several resolutions:
+ *   raw      the last TELEMETRY_ROLLUP_RAW_CAPACITY samples, none older
+ *            than TELEMETRY_ROLLUP_RAW_SECONDS: whichever bound is hit
+ *            first applies, so at 1 kHz the capacity keeps ~2 s, not 60
+ *   1 s      count/sum/min/max buckets, TELEMETRY_ROLLUP_SECONDS of them
+ *   1 min    TELEMETRY_ROLLUP_MINUTES buckets (1 day by default)
+ *   1 h      TELEMETRY_ROLLUP_HOURS buckets (30 days by default)
+ * in ~250 KiB of static memory, where 30 days of raw samples at 1 kHz
+ * would take 80 GB.
+ *
+ * Each level is a ring indexed by timestamp / width: a sample updates
+ * one bucket per level in O(1), and a slot whose stored index is older
+ * than the sample's is reset first, so expiry costs nothing. Samples
+ * older than a level's window are ignored by that level.
+ *
+ * telemetry_rollup_summarize() splits [from, to) into the coarsest
+ * buckets that fit inside it (hours in the middle, minutes then seconds
+ * at the edges), so a month-long query reads ~850 buckets. Where the
+ * finer levels have expired it widens to the enclosing coarser bucket
+ * and clears exact.
+ *
+ * All sensors of the stream share the buckets; keep one store per
+ * sensor for per-sensor history. A zeroed TelemetryRollup is empty.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c telemetry_rollup.c
+ */
+
+#ifndef TELEMETRY_ROLLUP_H
+#define TELEMETRY_ROLLUP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "telemetry_types.h"
+
+#ifndef TELEMETRY_ROLLUP_RAW_SECONDS
+#define TELEMETRY_ROLLUP_RAW_SECONDS 60     /* Raw age limit (seconds) */
+#endif
+#ifndef TELEMETRY_ROLLUP_RAW_CAPACITY
+#define TELEMETRY_ROLLUP_RAW_CAPACITY 2048  /* Raw samples held at most (Rule 3); the
+                                               effective bound above ~34 Hz */
+#endif
+#ifndef TELEMETRY_ROLLUP_SECONDS
+#define TELEMETRY_ROLLUP_SECONDS 3600       /* 1 s buckets: 1 hour */
+#endif
+#ifndef TELEMETRY_ROLLUP_MINUTES
+#define TELEMETRY_ROLLUP_MINUTES 1440       /* 1 min buckets: 1 day */
+#endif
+#ifndef TELEMETRY_ROLLUP_HOURS
+#define TELEMETRY_ROLLUP_HOURS 720          /* 1 h buckets: 30 days */
+#endif
+
+typedef enum {
+    TELEMETRY_ROLLUP_SECOND = 0,
+    TELEMETRY_ROLLUP_MINUTE = 1,
+    TELEMETRY_ROLLUP_HOUR = 2,
+    TELEMETRY_ROLLUP_LEVELS = 3
+} TelemetryRollupLevel;
+
+typedef struct {
+    uint32_t index;   /* Bucket start / width */
+    uint32_t count;   /* 0: empty slot */
+    double sum;
+    double min;
+    double max;
+} TelemetryRollupBucket;
+
+typedef struct {
+    uint64_t count;
+    double sum;
+    double min;
+    double max;
+    bool exact;       /* False if coarser buckets widened the range */
+} TelemetryRollupSummary;
+
+typedef struct {
+    TelemetryRollupBucket buckets[TELEMETRY_ROLLUP_SECONDS + TELEMETRY_ROLLUP_MINUTES +
+                                  TELEMETRY_ROLLUP_HOURS];  /* Levels back to back */
+    TelemetryData raw[TELEMETRY_ROLLUP_RAW_CAPACITY];        /* Ring, oldest at raw_tail */
+    size_t raw_tail;
+    size_t raw_count;
+    uint32_t newest;  /* Latest timestamp seen */
+    bool any;         /* newest is meaningful */
+} TelemetryRollup;
+
+void telemetry_rollup_init(TelemetryRollup *rollup);
+
+/* Fold one sample into every level; invalid samples are ignored */
+void telemetry_rollup_add(TelemetryRollup *rollup, const TelemetryData *sample);
+
+/* Aggregate of the samples with timestamp in [from, to) */
+void telemetry_rollup_summarize(const TelemetryRollup *rollup, uint32_t from, uint32_t to,
+                                TelemetryRollupSummary *out);
+
+/* Non-empty buckets of [from, to) at the finest level giving at most
+ * max_points buckets and still holding from; *level gets the level
+ * used. Returns the number of buckets written, oldest first. */
+size_t telemetry_rollup_series(const TelemetryRollup *rollup, uint32_t from, uint32_t to,
+                               size_t max_points, TelemetryRollupBucket *out,
+                               TelemetryRollupLevel *level);
+
+/* Raw samples still held with timestamp in [from, to), oldest first, up
+ * to max; older ones only survive in the buckets */
+size_t telemetry_rollup_raw(const TelemetryRollup *rollup, uint32_t from, uint32_t to,
+                            TelemetryData *out, size_t max);
+
+/* Bucket width of a level, in seconds */
+uint32_t telemetry_rollup_width(TelemetryRollupLevel level);
+
+#endif /* TELEMETRY_ROLLUP_H */
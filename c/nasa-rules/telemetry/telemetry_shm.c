@@ -0,0 +1,244 @@
+/*
+ * TELEMETRY SHM - Implementation
+ *
+ * Header seqlock, as in telemetry_ring:
+ *   producer: seq odd (relaxed), release fence, reset ring and fields,
+ *             seq even with release
+ *   reader:   seq with acquire, ring/field loads, acquire fence, reload
+ *             seq and compare
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "telemetry_shm.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+_Static_assert(ATOMIC_LONG_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+               "shared atomics must be lock-free to work across processes");
+
+#define SHM_OPEN_RETRIES 64  // A producer initializing the segment is brief
+
+static bool valid_name(const char *name) {
+    size_t len = strnlen(name, TELEMETRY_SHM_NAME_MAX);
+    return name[0] == '/' && len > 1 && len < TELEMETRY_SHM_NAME_MAX;
+}
+
+/* telemetry_ring_init() uses atomic_init, which readers still mapping a
+ * previous generation would race with: reset with atomic stores instead */
+static void reset_ring(TelemetryRing *ring) {
+    atomic_store_explicit(&ring->head, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->dropped, 0, memory_order_relaxed);
+    for (size_t i = 0; i < TELEMETRY_RING_CAPACITY; i++) {
+        atomic_store_explicit(&ring->slots[i].seq, 0, memory_order_relaxed);
+        for (size_t w = 0; w < TELEMETRY_RING_WORDS; w++) {
+            atomic_store_explicit(&ring->slots[i].words[w], 0, memory_order_relaxed);
+        }
+    }
+}
+
+static uint64_t realtime_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// ============================================
+// PRODUCER
+// ============================================
+
+bool telemetry_shm_create(TelemetryShmPublisher *publisher, const char *name) {
+    assert(publisher != NULL && name != NULL);
+
+    publisher->segment = NULL;
+    if (!valid_name(name)) {
+        return false;
+    }
+    int fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, (off_t)sizeof(TelemetryShmSegment)) != 0) {  // Rule 5
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, sizeof(TelemetryShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED,
+                     fd, 0);
+    close(fd);  // The mapping keeps the segment alive
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    TelemetryShmSegment *segment = map;
+    TelemetryShmHeader *header = &segment->header;
+
+    // New segments are zero-filled; an existing one (previous producer,
+    // maybe crashed mid-update) continues its generation count
+    uint64_t seq = atomic_load_explicit(&header->seq, memory_order_relaxed) | 1;
+    atomic_store_explicit(&header->seq, seq, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    reset_ring(&segment->ring);
+    atomic_store_explicit(&header->magic, TELEMETRY_SHM_MAGIC, memory_order_relaxed);
+    atomic_store_explicit(&header->version, TELEMETRY_SHM_VERSION, memory_order_relaxed);
+    atomic_store_explicit(&header->capacity, TELEMETRY_RING_CAPACITY, memory_order_relaxed);
+    atomic_store_explicit(&header->sample_size, (uint32_t)sizeof(TelemetryData),
+                          memory_order_relaxed);
+    atomic_store_explicit(&header->producer_pid, (uint64_t)getpid(), memory_order_relaxed);
+    atomic_store_explicit(&header->created_ns, realtime_ns(), memory_order_relaxed);
+
+    atomic_store_explicit(&header->seq, seq + 1, memory_order_release);
+
+    publisher->segment = segment;
+    memcpy(publisher->name, name, strlen(name) + 1);
+    return true;
+}
+
+TelemetryRing *telemetry_shm_ring(TelemetryShmPublisher *publisher) {
+    assert(publisher != NULL && publisher->segment != NULL);
+    return &publisher->segment->ring;
+}
+
+void telemetry_shm_close(TelemetryShmPublisher *publisher, bool unlink) {
+    assert(publisher != NULL && publisher->segment != NULL);
+
+    (void)munmap(publisher->segment, sizeof(TelemetryShmSegment));
+    publisher->segment = NULL;
+    if (unlink) {
+        (void)shm_unlink(publisher->name);
+    }
+}
+
+// ============================================
+// READERS
+// ============================================
+
+/* Header checked under the seqlock; false if the layout differs */
+static bool layout_matches(const TelemetryShmHeader *header) {
+    return atomic_load_explicit(&header->magic, memory_order_relaxed) == TELEMETRY_SHM_MAGIC &&
+           atomic_load_explicit(&header->version, memory_order_relaxed) == TELEMETRY_SHM_VERSION &&
+           atomic_load_explicit(&header->capacity, memory_order_relaxed) == TELEMETRY_RING_CAPACITY &&
+           atomic_load_explicit(&header->sample_size, memory_order_relaxed) == sizeof(TelemetryData);
+}
+
+bool telemetry_shm_open(TelemetryShmReader *reader, const char *name) {
+    assert(reader != NULL && name != NULL);
+
+    reader->segment = NULL;
+    if (!valid_name(name)) {
+        return false;
+    }
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size != sizeof(TelemetryShmSegment)) {
+        close(fd);
+        return false;  // Rule 5: Another build's layout, or still being sized
+    }
+    void *map = mmap(NULL, sizeof(TelemetryShmSegment), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    const TelemetryShmSegment *segment = map;
+    // Rule 2: Bounded retries while a producer initializes
+    for (int attempt = 0; attempt < SHM_OPEN_RETRIES; attempt++) {
+        uint64_t before = atomic_load_explicit(&segment->header.seq, memory_order_acquire);
+        if (before & 1) {
+            (void)sched_yield();
+            continue;
+        }
+        bool matches = layout_matches(&segment->header);
+        uint64_t head = telemetry_ring_published(&segment->ring);
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&segment->header.seq, memory_order_relaxed) != before) {
+            continue;
+        }
+        if (!matches || before == 0) {
+            break;  // Never initialized, or a foreign layout
+        }
+        reader->segment = segment;
+        reader->seq = before;
+        reader->cursor = (head > TELEMETRY_RING_CAPACITY) ? head - TELEMETRY_RING_CAPACITY : 0;
+        reader->restarts = 0;
+        return true;
+    }
+    (void)munmap(map, sizeof(TelemetryShmSegment));
+    return false;
+}
+
+void telemetry_shm_reader_close(TelemetryShmReader *reader) {
+    assert(reader != NULL && reader->segment != NULL);
+
+    // The mapping is read-only; the cast only matches munmap's signature
+    (void)munmap((void *)(uintptr_t)reader->segment, sizeof(TelemetryShmSegment));
+    reader->segment = NULL;
+}
+
+size_t telemetry_shm_read(TelemetryShmReader *reader, TelemetryData *out, size_t max,
+                          uint64_t *lost) {
+    assert(reader != NULL && reader->segment != NULL && lost != NULL);
+
+    const TelemetryShmHeader *header = &reader->segment->header;
+    uint64_t before = atomic_load_explicit(&header->seq, memory_order_acquire);
+    if (before & 1) {
+        return 0;
+    }
+    if (before != reader->seq) {
+        // New generation: its tickets restart at 0
+        reader->seq = before;
+        reader->cursor = 0;
+        reader->restarts++;
+    }
+
+    uint64_t cursor = reader->cursor;
+    uint64_t overwritten = 0;
+    size_t n = telemetry_ring_read(&reader->segment->ring, &cursor, out, max, &overwritten);
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&header->seq, memory_order_relaxed) != before) {
+        return 0;  // Reset during the copy: discard, the next call restarts
+    }
+    reader->cursor = cursor;
+    *lost += overwritten;
+    return n;
+}
+
+size_t telemetry_shm_latest(const TelemetryShmReader *reader, TelemetryData *out, size_t max) {
+    assert(reader != NULL && reader->segment != NULL);
+
+    const TelemetryShmHeader *header = &reader->segment->header;
+    uint64_t before = atomic_load_explicit(&header->seq, memory_order_acquire);
+    if (before & 1) {
+        return 0;
+    }
+    size_t n = telemetry_ring_snapshot(&reader->segment->ring, out, max);
+    atomic_thread_fence(memory_order_acquire);
+    return (atomic_load_explicit(&header->seq, memory_order_relaxed) == before) ? n : 0;
+}
+
+bool telemetry_shm_info(const TelemetryShmReader *reader, TelemetryShmInfo *out) {
+    assert(reader != NULL && reader->segment != NULL && out != NULL);
+
+    const TelemetryShmHeader *header = &reader->segment->header;
+    uint64_t before = atomic_load_explicit(&header->seq, memory_order_acquire);
+    if (before & 1) {
+        return false;
+    }
+    out->generation = before / 2;
+    out->producer_pid = atomic_load_explicit(&header->producer_pid, memory_order_relaxed);
+    out->created_ns = atomic_load_explicit(&header->created_ns, memory_order_relaxed);
+    out->published = telemetry_ring_published(&reader->segment->ring);
+    out->dropped = telemetry_ring_dropped(&reader->segment->ring);
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&header->seq, memory_order_relaxed) == before;
+}
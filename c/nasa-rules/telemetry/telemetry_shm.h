@@ -0,0 +1,100 @@
+/*
+ * TELEMETRY SHM - Telemetry ring published in POSIX shared memory
+ *
+ * The producer places its TelemetryRing in a named shm segment
+ * (shm_open + mmap) behind a small header; acquisition threads publish
+ * with telemetry_ring_publish() exactly as into a private ring. Reader
+ * processes map the segment PROT_READ and run the ring's lock-free read
+ * path on the shared pages: no syscall per sample, no copy through the
+ * kernel, and nothing a reader does can block or slow a producer (it
+ * never writes to the segment).
+ *
+ * The header is a seqlock: seq is odd while a producer (re)initializes
+ * the segment and advances by 2 each time one does. Readers check it
+ * around every read, so a restarted producer is seen as a new generation
+ * (cursor back to 0) instead of as garbage.
+ *
+ * Requires lock-free, address-free 64-bit atomics (any 64-bit target).
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c telemetry_shm.c
+ */
+
+#ifndef TELEMETRY_SHM_H
+#define TELEMETRY_SHM_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "telemetry_ring.h"
+#include "telemetry_types.h"
+
+#define TELEMETRY_SHM_MAGIC 0x544C4D52u   /* "TLMR" */
+#define TELEMETRY_SHM_VERSION 1u
+#define TELEMETRY_SHM_DEFAULT_NAME "/nasa_rules_telemetry"
+#define TELEMETRY_SHM_NAME_MAX 64      /* Including the terminator */
+
+/* Written only under seq; atomics so readers racing a restart are defined */
+typedef struct {
+    _Alignas(64) _Atomic uint64_t seq;  /* Odd while (re)initializing */
+    _Atomic uint32_t magic;
+    _Atomic uint32_t version;
+    _Atomic uint32_t capacity;          /* TELEMETRY_RING_CAPACITY */
+    _Atomic uint32_t sample_size;       /* sizeof(TelemetryData) */
+    _Atomic uint64_t producer_pid;
+    _Atomic uint64_t created_ns;        /* CLOCK_REALTIME */
+} TelemetryShmHeader;
+
+typedef struct {
+    TelemetryShmHeader header;
+    TelemetryRing ring;
+} TelemetryShmSegment;
+
+typedef struct {
+    TelemetryShmSegment *segment;
+    char name[TELEMETRY_SHM_NAME_MAX];
+} TelemetryShmPublisher;
+
+typedef struct {
+    const TelemetryShmSegment *segment;
+    uint64_t seq;       /* Generation the cursor belongs to */
+    uint64_t cursor;
+    uint64_t restarts;  /* Producer restarts seen */
+} TelemetryShmReader;
+
+typedef struct {
+    uint64_t generation;
+    uint64_t producer_pid;
+    uint64_t created_ns;
+    uint64_t published;
+    uint64_t dropped;
+} TelemetryShmInfo;
+
+/* Create (or take over) segment name ("/name") and initialize its ring */
+bool telemetry_shm_create(TelemetryShmPublisher *publisher, const char *name);
+
+/* The shared ring: publish into it with telemetry_ring_publish() */
+TelemetryRing *telemetry_shm_ring(TelemetryShmPublisher *publisher);
+
+/* Unmap; with unlink the name disappears (mapped readers keep their view) */
+void telemetry_shm_close(TelemetryShmPublisher *publisher, bool unlink);
+
+/* Map segment name read-only; the cursor starts at the oldest retained
+ * sample. False if it does not exist or has another layout. */
+bool telemetry_shm_open(TelemetryShmReader *reader, const char *name);
+
+void telemetry_shm_reader_close(TelemetryShmReader *reader);
+
+/* Like telemetry_ring_read() on the shared ring; returns 0 while a
+ * producer is (re)initializing the segment */
+size_t telemetry_shm_read(TelemetryShmReader *reader, TelemetryData *out, size_t max,
+                          uint64_t *lost);
+
+/* Like telemetry_ring_snapshot(): the newest samples, oldest first */
+size_t telemetry_shm_latest(const TelemetryShmReader *reader, TelemetryData *out, size_t max);
+
+/* Consistent copy of the header; false while it is being rewritten */
+bool telemetry_shm_info(const TelemetryShmReader *reader, TelemetryShmInfo *out);
+
+#endif /* TELEMETRY_SHM_H */
@@ -0,0 +1,22 @@
+/*
+ * TELEMETRY TYPES - Sample record shared by the telemetry modules
+ *
+ * Used by nasa_rules.c and by the telemetry subsystem (codec, archive,
+ * ...), so every module agrees on one layout.
+ */
+
+#ifndef TELEMETRY_TYPES_H
+#define TELEMETRY_TYPES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    int sensor_id;
+    double temperature;
+    uint32_t timestamp;  /* Unix seconds (CSV, codec and archive key) */
+    bool valid;
+    uint64_t time_ns;    /* Monotonic capture time, orders samples within a second */
+} TelemetryData;
+
+#endif /* TELEMETRY_TYPES_H */
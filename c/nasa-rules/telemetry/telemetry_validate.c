@@ -0,0 +1,177 @@
+/*
+ * TELEMETRY VALIDATE - Implementation
+ *
+ * Each 64-sample bitmap word is produced by one kernel call; the AVX2
+ * kernel is chosen at runtime so the binary still runs without AVX2.
+ */
+
+#include "telemetry_validate.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "cpu_features.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VALIDATE_HAVE_AVX2_PATH 1
+#include <immintrin.h>
+#else
+#define VALIDATE_HAVE_AVX2_PATH 0
+#endif
+
+#define WORD_BITS 64
+
+// ============================================
+// SCALAR KERNELS
+// ============================================
+
+/* Bits for temps[0..count), count <= 64; comparisons, no branches */
+static uint64_t validate_word_scalar(const double *temps, size_t count) {
+    uint64_t bits = 0;
+    for (size_t j = 0; j < count; j++) {
+        uint64_t ok = (uint64_t)((temps[j] >= TELEMETRY_TEMP_MIN) & (temps[j] <= TELEMETRY_TEMP_MAX));
+        bits |= ok << j;
+    }
+    return bits;
+}
+
+static size_t compact_word_scalar(const double *temps, uint64_t bits, double *out) {
+    size_t k = 0;
+    // Rule 2: At most 64 iterations, one per set bit
+    while (bits != 0) {
+        out[k++] = temps[__builtin_ctzll(bits)];
+        bits &= bits - 1;
+    }
+    return k;
+}
+
+// ============================================
+// AVX2 KERNELS
+// ============================================
+
+#if VALIDATE_HAVE_AVX2_PATH
+
+/* 32-bit lane permutation moving the selected doubles of a 4-bit mask
+ * to the front (each double is two 32-bit lanes) */
+static const uint32_t compact_permutation[16][8] = {
+    {0, 1, 2, 3, 4, 5, 6, 7}, {0, 1, 2, 3, 4, 5, 6, 7},
+    {2, 3, 0, 1, 4, 5, 6, 7}, {0, 1, 2, 3, 4, 5, 6, 7},
+    {4, 5, 0, 1, 2, 3, 6, 7}, {0, 1, 4, 5, 2, 3, 6, 7},
+    {2, 3, 4, 5, 0, 1, 6, 7}, {0, 1, 2, 3, 4, 5, 6, 7},
+    {6, 7, 0, 1, 2, 3, 4, 5}, {0, 1, 6, 7, 2, 3, 4, 5},
+    {2, 3, 6, 7, 0, 1, 4, 5}, {0, 1, 2, 3, 6, 7, 4, 5},
+    {4, 5, 6, 7, 0, 1, 2, 3}, {0, 1, 4, 5, 6, 7, 2, 3},
+    {2, 3, 4, 5, 6, 7, 0, 1}, {0, 1, 2, 3, 4, 5, 6, 7},
+};
+
+/* Bits for one full word of 64 samples */
+__attribute__((target("avx2")))
+static uint64_t validate_word_avx2(const double *temps) {
+    const __m256d lo = _mm256_set1_pd(TELEMETRY_TEMP_MIN);
+    const __m256d hi = _mm256_set1_pd(TELEMETRY_TEMP_MAX);
+    uint64_t bits = 0;
+
+    for (size_t j = 0; j < WORD_BITS; j += 16) {
+        uint64_t group = 0;
+        for (size_t v = 0; v < 4; v++) {
+            __m256d x = _mm256_loadu_pd(&temps[j + 4 * v]);
+            // Ordered compares: NaN fails both
+            __m256d ok = _mm256_and_pd(_mm256_cmp_pd(x, lo, _CMP_GE_OQ),
+                                       _mm256_cmp_pd(x, hi, _CMP_LE_OQ));
+            group |= (uint64_t)_mm256_movemask_pd(ok) << (4 * v);
+        }
+        bits |= group << j;
+    }
+    return bits;
+}
+
+/* Compact one full word; writes whole vectors, so out needs 64 slots */
+__attribute__((target("avx2")))
+static size_t compact_word_avx2(const double *temps, uint64_t bits, double *out) {
+    if (bits == UINT64_MAX) {
+        memcpy(out, temps, WORD_BITS * sizeof(double));
+        return WORD_BITS;
+    }
+
+    size_t k = 0;
+    for (size_t j = 0; j < WORD_BITS; j += 4) {
+        unsigned mask = (unsigned)(bits >> j) & 0xF;
+        __m256i perm = _mm256_loadu_si256((const __m256i *)compact_permutation[mask]);
+        __m256 x = _mm256_castpd_ps(_mm256_loadu_pd(&temps[j]));
+        __m256 packed = _mm256_permutevar8x32_ps(x, perm);
+        _mm256_storeu_pd(&out[k], _mm256_castps_pd(packed));
+        k += (size_t)__builtin_popcount(mask);
+    }
+    return k;
+}
+
+#endif /* VALIDATE_HAVE_AVX2_PATH */
+
+// ============================================
+// PUBLIC API
+// ============================================
+
+size_t telemetry_validate_batch(const double *temps, size_t n, uint64_t *valid_bitmap) {
+    assert(temps != NULL || n == 0);
+    assert(valid_bitmap != NULL || n == 0);
+
+    size_t valid = 0;
+    size_t words = n / WORD_BITS;
+
+#if VALIDATE_HAVE_AVX2_PATH
+    const bool use_avx2 = cpu_has_avx2();
+#endif
+
+    for (size_t w = 0; w < words; w++) {
+        const double *block = &temps[w * WORD_BITS];
+#if VALIDATE_HAVE_AVX2_PATH
+        uint64_t bits = use_avx2 ? validate_word_avx2(block)
+                                 : validate_word_scalar(block, WORD_BITS);
+#else
+        uint64_t bits = validate_word_scalar(block, WORD_BITS);
+#endif
+        valid_bitmap[w] = bits;
+        valid += (size_t)__builtin_popcountll(bits);
+    }
+
+    size_t tail = n % WORD_BITS;
+    if (tail > 0) {
+        uint64_t bits = validate_word_scalar(&temps[words * WORD_BITS], tail);
+        valid_bitmap[words] = bits;
+        valid += (size_t)__builtin_popcountll(bits);
+    }
+    return valid;
+}
+
+size_t telemetry_compact_valid(const double *temps, size_t n,
+                               const uint64_t *valid_bitmap, double *out) {
+    assert(temps != NULL || n == 0);
+    assert(valid_bitmap != NULL || n == 0);
+    assert(out != NULL || n == 0);
+
+    size_t k = 0;
+    size_t words = n / WORD_BITS;
+
+#if VALIDATE_HAVE_AVX2_PATH
+    const bool use_avx2 = cpu_has_avx2();
+#endif
+
+    for (size_t w = 0; w < words; w++) {
+        const double *block = &temps[w * WORD_BITS];
+        // k <= w * 64, so whole-vector stores stay inside out[0..n)
+#if VALIDATE_HAVE_AVX2_PATH
+        k += use_avx2 ? compact_word_avx2(block, valid_bitmap[w], &out[k])
+                      : compact_word_scalar(block, valid_bitmap[w], &out[k]);
+#else
+        k += compact_word_scalar(block, valid_bitmap[w], &out[k]);
+#endif
+    }
+
+    size_t tail = n % WORD_BITS;
+    if (tail > 0) {
+        uint64_t mask = (UINT64_C(1) << tail) - 1;
+        k += compact_word_scalar(&temps[words * WORD_BITS], valid_bitmap[words] & mask, &out[k]);
+    }
+    return k;
+}
@@ -0,0 +1,38 @@
+/*
+ * TELEMETRY VALIDATE - Branch-free batch range checks
+ *
+ * Validates a column of temperatures against the physical range
+ * [TELEMETRY_TEMP_MIN, TELEMETRY_TEMP_MAX] and records the result as a
+ * bitmap (bit i of word i / 64 set when temps[i] is valid), then
+ * compacts the valid values into a dense output column.
+ *
+ * With AVX2 (selected at runtime) four doubles are compared per
+ * instruction and movemask turns the result into bits; there is no
+ * data-dependent branch, so noisy sensors cost the same as clean ones.
+ * NaN is never valid.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -I../../common -c telemetry_validate.c
+ */
+
+#ifndef TELEMETRY_VALIDATE_H
+#define TELEMETRY_VALIDATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TELEMETRY_TEMP_MIN (-273.15)  /* Absolute zero */
+#define TELEMETRY_TEMP_MAX 1000.0
+
+/* Words needed for a bitmap of n samples */
+#define TELEMETRY_BITMAP_WORDS(n) (((n) + 63) / 64)
+
+/* Fill valid_bitmap[TELEMETRY_BITMAP_WORDS(n)] (bits past n are 0);
+ * returns the number of valid samples */
+size_t telemetry_validate_batch(const double *temps, size_t n, uint64_t *valid_bitmap);
+
+/* Copy the temps whose bit is set into out, in order; returns the count.
+ * out must hold n values (the SIMD path stores whole vectors). */
+size_t telemetry_compact_valid(const double *temps, size_t n,
+                               const uint64_t *valid_bitmap, double *out);
+
+#endif /* TELEMETRY_VALIDATE_H */
@@ -0,0 +1,147 @@
+/*
+ * TELEMETRY WINDOW - Implementation
+ */
+
+#include "telemetry_window.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+// ============================================
+// COMPENSATED SUMMATION (Neumaier)
+// ============================================
+
+static void compensated_add(CompensatedSum *acc, double value) {
+    double total = acc->sum + value;
+    if (fabs(acc->sum) >= fabs(value)) {
+        acc->compensation += (acc->sum - total) + value;
+    } else {
+        acc->compensation += (value - total) + acc->sum;
+    }
+    acc->sum = total;
+}
+
+static double compensated_value(const CompensatedSum *acc) {
+    return acc->sum + acc->compensation;
+}
+
+// ============================================
+// MONOTONIC DEQUE (fixed ring, Rule 3)
+// ============================================
+
+static size_t deque_index(const MonotonicDeque *dq, size_t offset) {
+    return (dq->head + offset) % TELEMETRY_WINDOW_MAX;
+}
+
+/* Drop entries from the back that the new value dominates, then append.
+ * keep_smaller selects a min-deque (true) or max-deque (false). */
+static void deque_push(MonotonicDeque *dq, double value, uint64_t seq,
+                       bool keep_smaller) {
+    // Rule 2: at most count pops
+    while (dq->count > 0) {
+        const WindowEntry *back = &dq->entries[deque_index(dq, dq->count - 1)];
+        bool dominated = keep_smaller ? (back->value >= value)
+                                      : (back->value <= value);
+        if (!dominated) {
+            break;
+        }
+        dq->count--;
+    }
+
+    assert(dq->count < TELEMETRY_WINDOW_MAX);
+    dq->entries[deque_index(dq, dq->count)] = (WindowEntry){ value, seq };
+    dq->count++;
+}
+
+static void deque_evict(MonotonicDeque *dq, uint64_t seq) {
+    if (dq->count > 0 && dq->entries[dq->head].seq == seq) {
+        dq->head = (dq->head + 1) % TELEMETRY_WINDOW_MAX;
+        dq->count--;
+    }
+}
+
+// ============================================
+// PUBLIC API
+// ============================================
+
+void telemetry_window_init(TelemetryWindow *window) {
+    assert(window != NULL);
+    memset(window, 0, sizeof(*window));
+}
+
+void telemetry_window_add(TelemetryWindow *window, double value) {
+    assert(window != NULL);
+    assert(window->count < TELEMETRY_WINDOW_MAX);
+    assert(isfinite(value));  // NaN would poison the running sums
+
+    if (window->count == 0) {
+        // Fresh window: re-anchor the shift and drop accumulated error
+        window->shift = value;
+        window->sum = (CompensatedSum){ 0.0, 0.0 };
+        window->sum_squares = (CompensatedSum){ 0.0, 0.0 };
+    }
+
+    double delta = value - window->shift;
+    compensated_add(&window->sum, delta);
+    compensated_add(&window->sum_squares, delta * delta);
+
+    deque_push(&window->min_deque, value, window->next_seq, true);
+    deque_push(&window->max_deque, value, window->next_seq, false);
+
+    window->next_seq++;
+    window->count++;
+}
+
+void telemetry_window_evict(TelemetryWindow *window, double value) {
+    assert(window != NULL);
+    assert(window->count > 0);
+
+    double delta = value - window->shift;
+    compensated_add(&window->sum, -delta);
+    compensated_add(&window->sum_squares, -(delta * delta));
+
+    deque_evict(&window->min_deque, window->oldest_seq);
+    deque_evict(&window->max_deque, window->oldest_seq);
+
+    window->oldest_seq++;
+    window->count--;
+}
+
+double telemetry_window_mean(const TelemetryWindow *window) {
+    assert(window != NULL);
+    if (window->count == 0) {
+        return 0.0;
+    }
+    return window->shift + compensated_value(&window->sum) / (double)window->count;
+}
+
+/* Population variance of the window */
+double telemetry_window_variance(const TelemetryWindow *window) {
+    assert(window != NULL);
+    if (window->count == 0) {
+        return 0.0;
+    }
+
+    const double n = (double)window->count;
+    const double sum = compensated_value(&window->sum);
+    const double variance = (compensated_value(&window->sum_squares) - sum * sum / n) / n;
+    return (variance > 0.0) ? variance : 0.0;  // Clamp rounding noise
+}
+
+double telemetry_window_min(const TelemetryWindow *window) {
+    assert(window != NULL);
+    if (window->count == 0) {
+        return 0.0;
+    }
+    return window->min_deque.entries[window->min_deque.head].value;
+}
+
+double telemetry_window_max(const TelemetryWindow *window) {
+    assert(window != NULL);
+    if (window->count == 0) {
+        return 0.0;
+    }
+    return window->max_deque.entries[window->max_deque.head].value;
+}
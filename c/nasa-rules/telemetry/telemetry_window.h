@@ -0,0 +1,68 @@
+/*
+ * TELEMETRY WINDOW - O(1) sliding-window aggregates
+ *
+ * Maintains count, mean, variance, min and max of the values currently
+ * in a FIFO window. The owner of the samples calls telemetry_window_add
+ * for every new value and telemetry_window_evict (oldest first, same
+ * value) for every value that leaves the window.
+ *
+ * - Sums are Neumaier-compensated and taken relative to a shift (the
+ *   first value added to an empty window), so the variance does not
+ *   suffer from catastrophic cancellation around large means.
+ * - Min/max use monotonic deques: amortized O(1) per add, O(1) evict.
+ *
+ * Compilation: gcc -Wall -Wextra -Werror -std=c11 -c telemetry_window.c
+ */
+
+#ifndef TELEMETRY_WINDOW_H
+#define TELEMETRY_WINDOW_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef TELEMETRY_WINDOW_MAX
+#define TELEMETRY_WINDOW_MAX 256  /* Max live values (Rule 3: fixed) */
+#endif
+
+typedef struct {
+    double sum;           /* Running sum */
+    double compensation;  /* Lost low-order bits */
+} CompensatedSum;
+
+typedef struct {
+    double value;
+    uint64_t seq;  /* Position in the stream, used to detect eviction */
+} WindowEntry;
+
+typedef struct {
+    WindowEntry entries[TELEMETRY_WINDOW_MAX];
+    size_t head;
+    size_t count;
+} MonotonicDeque;
+
+typedef struct {
+    size_t count;
+    uint64_t next_seq;    /* Sequence number of the next added value */
+    uint64_t oldest_seq;  /* Sequence number of the next evicted value */
+    double shift;         /* Reference value subtracted before summing */
+    CompensatedSum sum;          /* Sum of (x - shift) */
+    CompensatedSum sum_squares;  /* Sum of (x - shift)^2 */
+    MonotonicDeque min_deque;    /* Increasing values, front = min */
+    MonotonicDeque max_deque;    /* Decreasing values, front = max */
+} TelemetryWindow;
+
+void telemetry_window_init(TelemetryWindow *window);
+
+/* Add the newest value. Requires count < TELEMETRY_WINDOW_MAX. */
+void telemetry_window_add(TelemetryWindow *window, double value);
+
+/* Remove the oldest value; must be the value added count adds ago. */
+void telemetry_window_evict(TelemetryWindow *window, double value);
+
+/* All getters are O(1) and return 0.0 on an empty window */
+double telemetry_window_mean(const TelemetryWindow *window);
+double telemetry_window_variance(const TelemetryWindow *window);
+double telemetry_window_min(const TelemetryWindow *window);
+double telemetry_window_max(const TelemetryWindow *window);
+
+#endif /* TELEMETRY_WINDOW_H */
@@ -0,0 +1,181 @@
+/*
+ * GEN COMMAND TABLE - Perfect hash for the rule 1 command list
+ *
+ * Reads the verbs of rule01_commands.def (compiled in) and prints
+ * rule01_command_table.h: a hash-and-displace perfect hash where every
+ * verb owns one slot, so the parser does one command_hash(), one table
+ * probe and one memcmp() however many verbs there are.
+ *
+ * Construction (CHD-style): keys are split into ~n/4 buckets by the high
+ * half of their hash; buckets are placed largest first, each trying
+ * displacements 0, 1, ... until all of its keys land in free slots. The
+ * table has a power-of-two size >= 1.25 n. A new seed is tried if a
+ * bucket cannot be placed. The output only depends on the list.
+ *
+ * Usage: ./gen_command_table > rule01_command_table.h   (run by make)
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rule01_command_hash.h"
+
+#define MAX_COMMANDS 4096
+#define MAX_SLOTS 8192            /* Power of two >= 1.25 * MAX_COMMANDS */
+#define MAX_BUCKET_KEYS 32
+#define MAX_DISPLACEMENT 65535u   /* Fits the uint16_t table */
+#define MAX_SEEDS 256
+#define VALUES_PER_LINE 12
+
+static const char *const NAMES[] = {
+#define COMMAND(name, id, handler, arg_count) #name,
+#include "rule01_commands.def"
+#undef COMMAND
+};
+
+#define COMMAND_COUNT (sizeof(NAMES) / sizeof(NAMES[0]))
+
+_Static_assert(COMMAND_COUNT <= MAX_COMMANDS, "raise MAX_COMMANDS");
+
+static uint64_t hashes[MAX_COMMANDS];
+static uint32_t bucket_start[MAX_COMMANDS + 1];  /* Keys of bucket b: members[start[b]..start[b+1]) */
+static uint32_t members[MAX_COMMANDS];
+static uint16_t displacement[MAX_COMMANDS];
+static uint16_t slot_entry[MAX_SLOTS];           /* Command index + 1, 0 = free */
+
+static uint32_t slots_for(uint32_t count) {
+    uint32_t slots = 1;
+    while (slots < count + count / 4 + 1) {
+        slots <<= 1;
+    }
+    return slots;
+}
+
+/* Group key indexes by bucket (counting sort) */
+static void fill_buckets(uint64_t seed, uint32_t buckets) {
+    memset(bucket_start, 0, sizeof(bucket_start));
+    for (uint32_t k = 0; k < COMMAND_COUNT; k++) {
+        hashes[k] = command_hash(NAMES[k], strlen(NAMES[k]), seed);
+        bucket_start[command_bucket(hashes[k], buckets) + 1]++;
+    }
+    for (uint32_t b = 0; b < buckets; b++) {
+        bucket_start[b + 1] += bucket_start[b];
+    }
+    static uint32_t fill[MAX_COMMANDS];
+    memcpy(fill, bucket_start, buckets * sizeof(fill[0]));
+    for (uint32_t k = 0; k < COMMAND_COUNT; k++) {
+        members[fill[command_bucket(hashes[k], buckets)]++] = k;
+    }
+}
+
+/* First displacement sending every key of bucket b to a free, distinct slot */
+static bool place_bucket(uint32_t b, uint32_t slots) {
+    uint32_t size = bucket_start[b + 1] - bucket_start[b];
+    const uint32_t *keys = &members[bucket_start[b]];
+    uint32_t taken[MAX_BUCKET_KEYS];
+
+    for (uint32_t d = 0; d <= MAX_DISPLACEMENT; d++) {
+        bool fits = true;
+        for (uint32_t i = 0; i < size && fits; i++) {
+            taken[i] = command_slot(hashes[keys[i]], d, slots);
+            fits = (slot_entry[taken[i]] == 0);
+            for (uint32_t j = 0; j < i && fits; j++) {
+                fits = (taken[j] != taken[i]);
+            }
+        }
+        if (fits) {
+            for (uint32_t i = 0; i < size; i++) {
+                slot_entry[taken[i]] = (uint16_t)(keys[i] + 1);
+            }
+            displacement[b] = (uint16_t)d;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool build(uint64_t seed, uint32_t buckets, uint32_t slots) {
+    fill_buckets(seed, buckets);
+    memset(slot_entry, 0, sizeof(slot_entry));
+    memset(displacement, 0, sizeof(displacement));
+
+    // Largest buckets first, while the table is emptiest
+    for (uint32_t size = MAX_BUCKET_KEYS; size > 0; size--) {
+        for (uint32_t b = 0; b < buckets; b++) {
+            if (bucket_start[b + 1] - bucket_start[b] == size && !place_bucket(b, slots)) {
+                return false;
+            }
+        }
+    }
+    for (uint32_t b = 0; b < buckets; b++) {
+        if (bucket_start[b + 1] - bucket_start[b] > MAX_BUCKET_KEYS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool names_valid(size_t *name_max) {
+    *name_max = 0;
+    for (size_t k = 0; k < COMMAND_COUNT; k++) {
+        size_t length = strlen(NAMES[k]);
+        *name_max = (length > *name_max) ? length : *name_max;
+        for (size_t j = 0; j < k; j++) {
+            if (strcmp(NAMES[j], NAMES[k]) == 0) {
+                fprintf(stderr, "gen_command_table: %s listed twice\n", NAMES[k]);
+                return false;
+            }
+        }
+    }
+    return *name_max > 0;
+}
+
+static void print_array(const char *type, const char *name, const char *size,
+                        const uint16_t *values, uint32_t count) {
+    printf("static const %s %s[%s] = {", type, name, size);
+    for (uint32_t i = 0; i < count; i++) {
+        printf("%s%u%s", (i % VALUES_PER_LINE == 0) ? "\n    " : "", values[i],
+               (i + 1 < count) ? ", " : "\n");
+    }
+    printf("};\n");
+}
+
+int main(void) {
+    size_t name_max = 0;
+    if (!names_valid(&name_max)) {
+        return EXIT_FAILURE;
+    }
+
+    uint32_t buckets = (uint32_t)(COMMAND_COUNT + 3) / 4;
+    uint32_t slots = slots_for((uint32_t)COMMAND_COUNT);
+    uint64_t seed = 0;
+    bool built = false;
+    for (uint32_t attempt = 0; attempt < MAX_SEEDS && !built; attempt++) {
+        seed = 0x434D445441424C45ull + attempt;  /* "CMDTABLE" + attempt */
+        built = build(seed, buckets, slots);
+    }
+    if (!built) {
+        fprintf(stderr, "gen_command_table: no perfect hash found\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("/*\n"
+           " * RULE 1 COMMAND TABLE - Generated by tools/gen_command_table.c from\n"
+           " * rule01_commands.def. Do not edit: run make.\n"
+           " */\n\n"
+           "#ifndef RULE01_COMMAND_TABLE_H\n"
+           "#define RULE01_COMMAND_TABLE_H\n\n"
+           "#include <stdint.h>\n\n");
+    printf("#define COMMAND_HASH_SEED 0x%016llXull\n", (unsigned long long)seed);
+    printf("#define COMMAND_BUCKETS %uu\n", buckets);
+    printf("#define COMMAND_SLOTS %uu\n", slots);
+    printf("#define COMMAND_NAME_MAX %zu\n\n", name_max);
+    printf("/* Displacement of each bucket */\n");
+    print_array("uint16_t", "COMMAND_DISPLACEMENT", "COMMAND_BUCKETS", displacement, buckets);
+    printf("\n/* Command index + 1 in each slot, 0 = empty */\n");
+    print_array("uint16_t", "COMMAND_SLOT_ENTRY", "COMMAND_SLOTS", slot_entry, slots);
+    printf("\n#endif /* RULE01_COMMAND_TABLE_H */\n");
+    return EXIT_SUCCESS;
+}
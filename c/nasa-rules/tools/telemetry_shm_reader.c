@@ -0,0 +1,99 @@
+/*
+ * TELEMETRY SHM READER - Reference consumer of the published ring
+ *
+ * Maps the segment created by start_telemetry_publication() read-only,
+ * prints its header, then follows ingest and prints every new sample in
+ * the CSV format of save_telemetry_to_file(). Lost samples (overwritten
+ * before this reader got to them) and producer restarts go to stderr.
+ * The producer never waits for this process.
+ *
+ * Usage: ./telemetry_shm_reader [name] [count]
+ *   name   segment name (default /nasa_rules_telemetry)
+ *   count  stop after this many samples (default: until Ctrl-C)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "telemetry_csv.h"
+#include "telemetry_shm.h"
+
+#define READ_BATCH 256
+#define IDLE_SLEEP_NS 1000000L  /* Poll period when nothing is new */
+
+static volatile sig_atomic_t stop_requested = 0;
+static TelemetryData batch[READ_BATCH];
+
+static void on_signal(int signo) {
+    (void)signo;
+    stop_requested = 1;
+}
+
+static void print_header(const TelemetryShmReader *reader, const char *name) {
+    TelemetryShmInfo info;
+    if (!telemetry_shm_info(reader, &info)) {
+        fprintf(stderr, "%s: producer is restarting\n", name);
+        return;
+    }
+    fprintf(stderr, "%s: generation %llu, producer pid %llu, %llu published, %llu dropped\n",
+            name, (unsigned long long)info.generation, (unsigned long long)info.producer_pid,
+            (unsigned long long)info.published, (unsigned long long)info.dropped);
+}
+
+int main(int argc, char **argv) {
+    const char *name = (argc > 1) ? argv[1] : TELEMETRY_SHM_DEFAULT_NAME;
+    unsigned long long limit = (argc > 2) ? strtoull(argv[2], NULL, 10) : 0;
+
+    TelemetryShmReader reader;
+    if (!telemetry_shm_open(&reader, name)) {
+        fprintf(stderr, "%s: no telemetry segment (or built with another layout)\n", name);
+        return EXIT_FAILURE;
+    }
+    print_header(&reader, name);
+
+    struct sigaction action = {0};
+    action.sa_handler = on_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    const struct timespec idle = {0, IDLE_SLEEP_NS};
+    unsigned long long printed = 0;
+    uint64_t lost = 0;
+    uint64_t restarts = 0;
+    char line[TELEMETRY_CSV_MAX_LINE];
+
+    // Follow loop: ends on the sample limit or a signal
+    while (!stop_requested && (limit == 0 || printed < limit)) {
+        uint64_t lost_before = lost;
+        size_t n = telemetry_shm_read(&reader, batch, READ_BATCH, &lost);
+        if (lost != lost_before) {
+            fprintf(stderr, "%s: %llu samples overwritten before they were read\n", name,
+                    (unsigned long long)(lost - lost_before));
+        }
+        if (reader.restarts != restarts) {
+            restarts = reader.restarts;
+            print_header(&reader, name);
+        }
+        for (size_t i = 0; i < n && (limit == 0 || printed < limit); i++) {
+            size_t len = telemetry_csv_format_line(line, batch[i].sensor_id,
+                                                   batch[i].temperature, batch[i].timestamp);
+            fwrite(line, 1, len, stdout);
+            printed++;
+        }
+        if (n == 0) {
+            fflush(stdout);
+            nanosleep(&idle, NULL);
+        }
+    }
+
+    fflush(stdout);
+    fprintf(stderr, "%s: %llu samples read, %llu lost\n", name, printed,
+            (unsigned long long)lost);
+    telemetry_shm_reader_close(&reader);
+    return EXIT_SUCCESS;
+}